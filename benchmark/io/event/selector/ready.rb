@@ -0,0 +1,61 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "sus/fixtures/benchmark"
+require "io/event"
+
+# Measures the throughput of the ready queue for each selector backend: pushing
+# fibers (e.g. when a condition is signalled) and flushing them on the next
+# select.
+#
+# Run with: bundle exec sus --verbose benchmark/io/event/selector/ready.rb
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	next unless klass.respond_to?(:new)
+	
+	describe "#{klass}" do
+		include Sus::Fixtures::Benchmark
+		
+		# A fiber which returns immediately when it is resumed, so only the cost of the queue itself is measured.
+		fiber = Object.new
+		def fiber.alive? = true
+		def fiber.transfer = nil
+		
+		measure "push and flush" do |repeats|
+			selector = klass.new(Fiber.current)
+			
+			repeats.times do
+				selector.push(fiber)
+				selector.select(0)
+			end
+			
+			selector.close
+		end
+		
+		# Many fibers become ready at once, e.g. when a queue hands off a batch of items:
+		measure "push 100 and flush" do |repeats|
+			selector = klass.new(Fiber.current)
+			
+			repeats.times do
+				100.times{selector.push(fiber)}
+				selector.select(0)
+			end
+			
+			selector.close
+		end
+		
+		measure "push remote and flush" do |repeats|
+			selector = klass.new(Fiber.current)
+			
+			repeats.times do
+				selector.push_remote(fiber)
+				selector.select(0)
+			end
+			
+			selector.close
+		end
+	end
+end
@@ -5,17 +5,22 @@
 
 require "sus/fixtures/benchmark"
 require "io/event/timers"
+require "io/event"
 
 # Measures timer scheduling and cancellation behavior, including the cost of
-# retaining cancelled timers in the priority heap.
+# retaining cancelled timers in the priority heap. The native implementation is
+# measured alongside the pure Ruby one when it is available, as is the pure Ruby
+# implementation with a timing wheel.
 #
 # Run with: bundle exec sus --verbose benchmark/io/event/timers.rb
 
-describe IO::Event::Timers do
+COUNT = 10_000
+CHURN_COUNT = 1_000_000
+CHURN_BATCH = 1_000
+
+TimersBenchmark = Sus::Shared("timers benchmark") do
 	include Sus::Fixtures::Benchmark
 	
-	COUNT = 10_000
-	
 	def schedule_and_flush(timers, count, base_time: timers.now, offset: 0)
 		count.times do |index|
 			timers.schedule(base_time + offset + index, proc{})
@@ -37,7 +42,7 @@ describe IO::Event::Timers do
 	
 	measure "schedule and flush #{COUNT} timers" do |repeats|
 		repeats.exactly(16).times do
-			timers = subject.new
+			timers = build_timers
 			
 			schedule_and_flush(timers, COUNT)
 		end
@@ -45,7 +50,7 @@ describe IO::Event::Timers do
 	
 	measure "cancel #{COUNT} timers before flush" do |repeats|
 		repeats.exactly(16).times do
-			timers = subject.new
+			timers = build_timers
 			handles = []
 			base_time = timers.now
 			
@@ -60,7 +65,7 @@ describe IO::Event::Timers do
 	
 	measure "cancel #{COUNT} timers after flush" do |repeats|
 		repeats.exactly(16).times do
-			timers = subject.new
+			timers = build_timers
 			
 			schedule_flush_and_cancel(timers, COUNT)
 		end
@@ -68,7 +73,7 @@ describe IO::Event::Timers do
 	
 	measure "schedule and flush #{COUNT} timers after #{COUNT} cancelled heap timers" do |repeats|
 		repeats.exactly(16).times do
-			timers = subject.new
+			timers = build_timers
 			base_time = timers.now
 			
 			schedule_flush_and_cancel(timers, COUNT, base_time: base_time, offset: COUNT)
@@ -78,11 +83,54 @@ describe IO::Event::Timers do
 	
 	measure "wait interval with #{COUNT} cancelled heap timers" do |repeats|
 		repeats.exactly(16).times do
-			timers = subject.new
+			timers = build_timers
 			base_time = timers.now
 			
 			schedule_flush_and_cancel(timers, COUNT, base_time: base_time)
 			timers.wait_interval(base_time)
 		end
 	end
+	
+	# Simulates I/O timeouts: each operation schedules a timeout which the event loop flushes before the operation completes and cancels it.
+	measure "churn #{CHURN_COUNT} schedule/cancel pairs" do |repeats|
+		repeats.exactly(1).times do
+			timers = build_timers
+			handles = Array.new(CHURN_BATCH)
+			
+			(CHURN_COUNT / CHURN_BATCH).times do
+				CHURN_BATCH.times do |index|
+					handles[index] = timers.after(0.5){}
+				end
+				
+				timers.wait_interval
+				handles.each(&:cancel!)
+			end
+		end
+	end
+end
+
+describe IO::Event::Timers do
+	def build_timers
+		subject.new
+	end
+	
+	it_behaves_like TimersBenchmark
+	
+	with "resolution: 0.001" do
+		def build_timers
+			subject.new(resolution: 0.001)
+		end
+		
+		it_behaves_like TimersBenchmark
+	end
+end
+
+if defined?(IO::Event::NativeTimers)
+	describe IO::Event::NativeTimers do
+		def build_timers
+			subject.new
+		end
+		
+		it_behaves_like TimersBenchmark
+	end
 end
@@ -25,7 +25,7 @@ if ENV.key?("RUBY_DEBUG")
 	append_cflags(["-DRUBY_DEBUG", "-O0"])
 end
 
-$srcs = ["io/event/event.c", "io/event/time.c", "io/event/fiber.c", "io/event/selector/selector.c"]
+$srcs = ["io/event/event.c", "io/event/time.c", "io/event/fiber.c", "io/event/timers.c", "io/event/selector/selector.c"]
 $VPATH << "$(srcdir)/io/event"
 $VPATH << "$(srcdir)/io/event/selector"
 
@@ -34,6 +34,11 @@ have_func("&rb_fiber_transfer")
 
 if have_library("uring") and have_header("liburing.h")
 	have_func("io_uring_prep_waitid", "liburing.h")
+	have_func("io_uring_setup_buf_ring", "liburing.h")
+	have_func("io_uring_prep_multishot_accept", "liburing.h")
+	have_func("io_uring_prep_poll_multishot", "liburing.h")
+	have_func("io_uring_register_files_sparse", "liburing.h")
+	have_func("io_uring_prep_send_zc", "liburing.h")
 	$srcs << "io/event/selector/uring.c"
 end
 
@@ -47,6 +52,10 @@ end
 
 have_header("sys/wait.h")
 
+# Used by `EPoll` and `URing` to attempt reads and writes without blocking (`RWF_NOWAIT`):
+have_func("preadv2", "sys/uio.h")
+have_func("pwritev2", "sys/uio.h")
+
 have_header("sys/eventfd.h")
 $srcs << "io/event/interrupt.c"
 
@@ -7,6 +7,8 @@
 
 void Init_IO_Event(void);
 
+#include "timers.h"
+
 #ifdef HAVE_LIBURING_H
 #include "selector/uring.h"
 #endif
@@ -7,6 +7,10 @@
 #include "../array.h"
 
 #include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <time.h>
 #include <errno.h>
 #include <unistd.h>
@@ -14,11 +18,23 @@
 #include "pidfd.c"
 #include "../interrupt.h"
 
+#ifdef HAVE_RUBY_IO_BUFFER_H
+#include "iovec.h"
+#endif
+
 enum {
 	DEBUG = 0,
 };
 
-enum {EPOLL_MAX_EVENTS = 64};
+enum {
+	// The default number of events returned by a single call to `epoll_wait`:
+	EPOLL_MAX_EVENTS = 64,
+	
+	// The event buffer grows up to this size when `epoll_wait` keeps returning full batches:
+	EPOLL_MAX_EVENTS_LIMIT = 1024,
+};
+
+static ID id_max_events;
 
 // This represents an actual fiber waiting for a specific event.
 struct IO_Event_Selector_EPoll_Waiting
@@ -45,6 +61,25 @@ struct IO_Event_Selector_EPoll
 	
 	struct IO_Event_Interrupt interrupt;
 	struct IO_Event_Array descriptors;
+	
+	// Whether new registrations use edge-triggered mode:
+	int edge_triggered;
+	
+	// The buffer which `epoll_wait` fills with events, reused by every call to `select`:
+	struct epoll_event *events;
+	int max_events;
+	
+	// The size which the event buffer may grow to:
+	int max_events_limit;
+	
+	// Batch statistics, counting calls to `epoll_wait` which returned at least one event:
+	size_t batches;
+	size_t batch_events;
+	size_t batch_capacity;
+	size_t full_batches;
+	
+	// The number of `epoll_ctl` calls made to register, modify or remove descriptors:
+	size_t epoll_ctls;
 };
 
 // This represents zero or more fibers waiting for a specific descriptor.
@@ -60,6 +95,15 @@ struct IO_Event_Selector_EPoll_Descriptor
 	
 	// The union of events we are registered for:
 	enum IO_Event registered_events;
+	
+	// Whether the descriptor is registered in edge-triggered mode, in which case it stays registered for all events until the IO changes:
+	int edge_triggered;
+	
+	// The IO for which an operation failed with `ENOTSOCK`, which then changes its file status flags rather than using `MSG_DONTWAIT`. Any other IO using the descriptor might be a socket again. It's only compared and never dereferenced, so it isn't marked, which would retain the IO:
+	VALUE not_socket;
+	
+	// The readiness (epoll flags) reported by the kernel which no fiber has consumed yet, cleared when an operation fails with `EAGAIN`:
+	uint32_t ready;
 };
 
 static
@@ -144,8 +188,13 @@ void IO_Event_Selector_EPoll_Type_free(void *_selector)
 	
 	close_internal(selector);
 	
+	IO_Event_Selector_free(&selector->backend);
 	IO_Event_Array_free(&selector->descriptors);
 	
+	if (selector->events) {
+		xfree(selector->events);
+	}
+	
 	xfree(selector);
 }
 
@@ -156,6 +205,7 @@ size_t IO_Event_Selector_EPoll_Type_size(const void *_selector)
 	
 	return sizeof(struct IO_Event_Selector_EPoll)
 		+ IO_Event_Array_memory_size(&selector->descriptors)
+		+ selector->max_events * sizeof(struct epoll_event)
 	;
 }
 
@@ -195,6 +245,23 @@ uint32_t epoll_flags_from_events(int events)
 	return flags;
 }
 
+// The epoll flags which are consumed by delivering the given events. Hang ups and errors are reported as readable, so they are consumed along with it. However, an edge-triggered descriptor won't report a hang up again, even though it persists, so in that case it is kept.
+static inline
+uint32_t epoll_flags_consumed_by_events(int events, int edge_triggered)
+{
+	uint32_t flags = 0;
+	
+	if (events & IO_EVENT_READABLE) {
+		flags |= EPOLLIN|EPOLLERR;
+		if (!edge_triggered) flags |= EPOLLHUP;
+	}
+	
+	if (events & IO_EVENT_PRIORITY) flags |= EPOLLPRI;
+	if (events & IO_EVENT_WRITABLE) flags |= EPOLLOUT;
+	
+	return flags;
+}
+
 static inline
 int events_from_epoll_flags(uint32_t flags)
 {
@@ -211,28 +278,46 @@ int events_from_epoll_flags(uint32_t flags)
 	return events;
 }
 
+// The descriptor is now used by a different IO, so everything we know about its registration is stale.
+inline static
+void IO_Event_Selector_EPoll_Descriptor_reset(struct IO_Event_Selector_EPoll *selector, VALUE io, struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor)
+{
+	epoll_descriptor->registered_events = 0;
+	epoll_descriptor->edge_triggered = 0;
+	epoll_descriptor->ready = 0;
+	RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, io);
+}
+
 inline static
 int IO_Event_Selector_EPoll_Descriptor_update(struct IO_Event_Selector_EPoll *selector, VALUE io, int descriptor, struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor)
 {
 	if (epoll_descriptor->io == io) {
+		if (epoll_descriptor->edge_triggered) {
+			// Edge-triggered descriptors stay registered for all events.
+			return 0;
+		}
+		
 		if (epoll_descriptor->registered_events == epoll_descriptor->waiting_events) {
 			// All the events we are interested in are already registered.
 			return 0;
 		}
 	} else {
 		// The IO has changed, we need to reset the state:
-		epoll_descriptor->registered_events = 0;
-		RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, io);
+		IO_Event_Selector_EPoll_Descriptor_reset(selector, io, epoll_descriptor);
 	}
 	
 	if (epoll_descriptor->waiting_events == 0) {
 		if (epoll_descriptor->registered_events) {
 			// We are no longer interested in any events.
 			epoll_ctl(selector->descriptor, EPOLL_CTL_DEL, descriptor, NULL);
+			selector->epoll_ctls += 1;
 			epoll_descriptor->registered_events = 0;
 		}
 		
-		RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, 0);
+		// Keep the IO while readiness is cached, so that the next `io_wait` can use it:
+		if (!epoll_descriptor->ready) {
+			RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, 0);
+		}
 		
 		return 0;
 	}
@@ -243,6 +328,11 @@ int IO_Event_Selector_EPoll_Descriptor_update(struct IO_Event_Selector_EPoll *se
 		.data = {.fd = descriptor},
 	};
 	
+	if (selector->edge_triggered) {
+		// Register for all events once, so that waiting for different events never needs to modify the registration:
+		event.events = epoll_flags_from_events(IO_EVENT_READABLE|IO_EVENT_PRIORITY|IO_EVENT_WRITABLE) | EPOLLET;
+	}
+	
 	int operation;
 	
 	if (epoll_descriptor->registered_events) {
@@ -252,11 +342,15 @@ int IO_Event_Selector_EPoll_Descriptor_update(struct IO_Event_Selector_EPoll *se
 	}
 	
 	int result = epoll_ctl(selector->descriptor, operation, descriptor, &event);
+	selector->epoll_ctls += 1;
+	
 	if (result == -1) {
 		if (errno == ENOENT) {
 			result = epoll_ctl(selector->descriptor, EPOLL_CTL_ADD, descriptor, &event);
+			selector->epoll_ctls += 1;
 		} else if (errno == EEXIST) {
 			result = epoll_ctl(selector->descriptor, EPOLL_CTL_MOD, descriptor, &event);
+			selector->epoll_ctls += 1;
 		}
 		
 		if (result == -1) {
@@ -264,11 +358,45 @@ int IO_Event_Selector_EPoll_Descriptor_update(struct IO_Event_Selector_EPoll *se
 		}
 	}
 	
-	epoll_descriptor->registered_events = epoll_descriptor->waiting_events;
+	if (selector->edge_triggered) {
+		epoll_descriptor->registered_events = IO_EVENT_READABLE|IO_EVENT_PRIORITY|IO_EVENT_WRITABLE;
+		epoll_descriptor->edge_triggered = 1;
+	} else {
+		epoll_descriptor->registered_events = epoll_descriptor->waiting_events;
+	}
 	
 	return 1;
 }
 
+// Edge-triggered descriptors stay registered, so the IO must be released once no fiber is waiting for it and no readiness is cached, otherwise it could never be garbage collected. The registration is kept, and readiness reported in the meantime is still cached.
+inline static
+void IO_Event_Selector_EPoll_Descriptor_release(struct IO_Event_Selector_EPoll *selector, struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor)
+{
+	if (epoll_descriptor->edge_triggered && epoll_descriptor->io && !epoll_descriptor->ready && IO_Event_List_empty(&epoll_descriptor->list)) {
+		epoll_descriptor->waiting_events = 0;
+		RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, 0);
+	}
+}
+
+// Waiting on a released edge-triggered descriptor: if it still refers to the registered file, modifying the registration succeeds and the cached readiness remains valid. Otherwise, the descriptor was closed and reused, so it must be registered again.
+inline static
+void IO_Event_Selector_EPoll_Descriptor_acquire(struct IO_Event_Selector_EPoll *selector, VALUE io, int descriptor, struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor)
+{
+	struct epoll_event event = {
+		.events = epoll_flags_from_events(IO_EVENT_READABLE|IO_EVENT_PRIORITY|IO_EVENT_WRITABLE) | EPOLLET,
+		.data = {.fd = descriptor},
+	};
+	
+	int result = epoll_ctl(selector->descriptor, EPOLL_CTL_MOD, descriptor, &event);
+	selector->epoll_ctls += 1;
+	
+	if (result == 0) {
+		RB_OBJ_WRITE(selector->backend.self, &epoll_descriptor->io, io);
+	} else {
+		IO_Event_Selector_EPoll_Descriptor_reset(selector, io, epoll_descriptor);
+	}
+}
+
 inline static
 int IO_Event_Selector_EPoll_Waiting_register(struct IO_Event_Selector_EPoll *selector, VALUE io, int descriptor, struct IO_Event_Selector_EPoll_Waiting *waiting)
 {
@@ -299,6 +427,9 @@ void IO_Event_Selector_EPoll_Descriptor_initialize(void *element)
 	epoll_descriptor->io = 0;
 	epoll_descriptor->waiting_events = 0;
 	epoll_descriptor->registered_events = 0;
+	epoll_descriptor->edge_triggered = 0;
+	epoll_descriptor->not_socket = Qnil;
+	epoll_descriptor->ready = 0;
 }
 
 void IO_Event_Selector_EPoll_Descriptor_free(void *element)
@@ -315,6 +446,15 @@ VALUE IO_Event_Selector_EPoll_allocate(VALUE self) {
 	IO_Event_Selector_initialize(&selector->backend, self, Qnil);
 	selector->descriptor = -1;
 	selector->owner = 0;
+	selector->edge_triggered = 0;
+	selector->events = NULL;
+	selector->max_events = 0;
+	selector->max_events_limit = 0;
+	selector->batches = 0;
+	selector->batch_events = 0;
+	selector->batch_capacity = 0;
+	selector->full_batches = 0;
+	selector->epoll_ctls = 0;
 	selector->descriptors.element_initialize = IO_Event_Selector_EPoll_Descriptor_initialize;
 	selector->descriptors.element_free = IO_Event_Selector_EPoll_Descriptor_free;
 	IO_Event_Array_initialize(&selector->descriptors, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_EPoll_Descriptor));
@@ -337,10 +477,37 @@ void IO_Event_Interrupt_add(struct IO_Event_Interrupt *interrupt, struct IO_Even
 	}
 }
 
-VALUE IO_Event_Selector_EPoll_initialize(VALUE self, VALUE loop) {
+// `EPoll.new(loop, max_events: 64)`: The event buffer starts with `max_events` entries, and doubles in size whenever `epoll_wait` fills it, up to 1024 entries (or `max_events`, if that is larger).
+VALUE IO_Event_Selector_EPoll_initialize(int argc, VALUE *argv, VALUE self) {
 	struct IO_Event_Selector_EPoll *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
 	
+	VALUE loop, kwargs = Qnil;
+	rb_scan_args(argc, argv, "1:", &loop, &kwargs);
+	
+	VALUE kwvals[1] = {Qundef};
+	if (!NIL_P(kwargs)) {
+		ID kwkeys[1] = {id_max_events};
+		rb_get_kwargs(kwargs, kwkeys, 0, 1, kwvals);
+	}
+	
+	int max_events = EPOLL_MAX_EVENTS;
+	if (kwvals[0] != Qundef && !NIL_P(kwvals[0])) {
+		max_events = NUM2INT(kwvals[0]);
+		
+		if (max_events <= 0) {
+			rb_raise(rb_eArgError, "max_events must be greater than 0!");
+		}
+	}
+	
+	if (selector->events) {
+		xfree(selector->events);
+	}
+	
+	selector->events = ALLOC_N(struct epoll_event, max_events);
+	selector->max_events = max_events;
+	selector->max_events_limit = max_events > EPOLL_MAX_EVENTS_LIMIT ? max_events : EPOLL_MAX_EVENTS_LIMIT;
+	
 	IO_Event_Selector_initialize(&selector->backend, self, loop);
 	int result = epoll_create1(EPOLL_CLOEXEC);
 	
@@ -437,7 +604,7 @@ VALUE IO_Event_Selector_EPoll_ready_p(VALUE self) {
 	struct IO_Event_Selector_EPoll *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
 	
-	return selector->backend.ready ? Qtrue : Qfalse;
+	return IO_Event_Selector_ready_p(&selector->backend) ? Qtrue : Qfalse;
 }
 
 struct process_wait_arguments {
@@ -530,6 +697,7 @@ VALUE IO_Event_Selector_EPoll_process_wait(VALUE self, VALUE fiber, VALUE _pid,
 struct io_wait_arguments {
 	struct IO_Event_Selector_EPoll *selector;
 	struct IO_Event_Selector_EPoll_Waiting *waiting;
+	int descriptor;
 };
 
 static
@@ -538,6 +706,13 @@ VALUE io_wait_ensure(VALUE _arguments) {
 	
 	IO_Event_Selector_EPoll_Waiting_cancel(arguments->waiting);
 	
+	if (!arguments->waiting->ready) {
+		arguments->selector->backend.statistics.cancellations += 1;
+		
+		// Nothing else may be waiting for the descriptor:
+		IO_Event_Selector_EPoll_Descriptor_release(arguments->selector, IO_Event_Selector_EPoll_Descriptor_lookup(arguments->selector, arguments->descriptor));
+	}
+	
 	return Qnil;
 };
 
@@ -568,6 +743,24 @@ VALUE IO_Event_Selector_EPoll_io_wait(VALUE self, VALUE fiber, VALUE io, VALUE e
 		.events = RB_NUM2INT(events),
 	};
 	
+	struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor = IO_Event_Selector_EPoll_Descriptor_lookup(selector, descriptor);
+	
+	if (epoll_descriptor->io == 0 && epoll_descriptor->edge_triggered) {
+		IO_Event_Selector_EPoll_Descriptor_acquire(selector, io, descriptor, epoll_descriptor);
+	}
+	
+	if (epoll_descriptor->io == io) {
+		enum IO_Event ready = events_from_epoll_flags(epoll_descriptor->ready) & waiting.events;
+		
+		if (ready) {
+			// Consume the cached readiness:
+			epoll_descriptor->ready &= ~epoll_flags_consumed_by_events(ready, epoll_descriptor->edge_triggered);
+			IO_Event_Selector_EPoll_Descriptor_release(selector, epoll_descriptor);
+			
+			return RB_INT2NUM(ready);
+		}
+	}
+	
 	RB_OBJ_WRITTEN(self, Qundef, fiber);
 	
 	int result = IO_Event_Selector_EPoll_Waiting_register(selector, io, descriptor, &waiting);
@@ -585,11 +778,63 @@ VALUE IO_Event_Selector_EPoll_io_wait(VALUE self, VALUE fiber, VALUE io, VALUE e
 	struct io_wait_arguments io_wait_arguments = {
 		.selector = selector,
 		.waiting = &waiting,
+		.descriptor = descriptor,
 	};
 	
 	return rb_ensure(io_wait_transfer, (VALUE)&io_wait_arguments, io_wait_ensure, (VALUE)&io_wait_arguments);
 }
 
+// Wait for the given events after an operation failed with `EAGAIN`, which means any cached readiness for them is stale.
+static
+VALUE IO_Event_Selector_EPoll_io_wait_again(VALUE self, VALUE fiber, VALUE io, enum IO_Event events) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	struct IO_Event_Selector_EPoll_Descriptor *epoll_descriptor = IO_Event_Selector_EPoll_Descriptor_lookup(selector, IO_Event_Selector_io_descriptor(io));
+	epoll_descriptor->ready &= ~epoll_flags_consumed_by_events(events, 0);
+	
+	return IO_Event_Selector_EPoll_io_wait(self, fiber, io, RB_INT2NUM(events));
+}
+
+// Sockets are read and written using `MSG_DONTWAIT`, so their file status flags don't need to be changed, which would otherwise take up to three `fcntl` calls per operation. Returns whether the IO should be treated as a socket.
+static
+int IO_Event_Selector_EPoll_socket_p(VALUE self, VALUE io, int descriptor) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	return IO_Event_Selector_EPoll_Descriptor_lookup(selector, descriptor)->not_socket != io;
+}
+
+// The operation failed with `ENOTSOCK`, so remember that the IO is not a socket, and make it non-blocking instead, returning the original flags.
+static
+int IO_Event_Selector_EPoll_socket_fallback(VALUE self, VALUE io, int descriptor) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	IO_Event_Selector_EPoll_Descriptor_lookup(selector, descriptor)->not_socket = io;
+	
+	return IO_Event_Selector_nonblock_set(descriptor);
+}
+
+VALUE IO_Event_Selector_EPoll_edge_triggered(VALUE self) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	return selector->edge_triggered ? Qtrue : Qfalse;
+}
+
+// Register descriptors in edge-triggered mode (`EPOLLET`). Each descriptor is registered once for all events and stays registered, so waiting doesn't need `epoll_ctl` calls, and readiness which no fiber was waiting for is cached until it is consumed by `io_wait`. Once no fiber is waiting for a descriptor and no readiness is cached, its IO is released so that it can be garbage collected, and the next wait needs one `epoll_ctl` call to check that the descriptor still refers to the registered file.
+//
+// Edge-triggered readiness is only reported again after new data arrives, so callers must only wait after an operation failed with `EAGAIN`, as `io_read` and `io_write` do. Otherwise, waiting may block even though the IO is ready. This only applies to descriptors registered after it is enabled.
+VALUE IO_Event_Selector_EPoll_edge_triggered_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	selector->edge_triggered = RTEST(value);
+	
+	return value;
+}
+
 #ifdef HAVE_RUBY_IO_BUFFER_H
 
 struct io_read_arguments {
@@ -597,6 +842,8 @@ struct io_read_arguments {
 	VALUE fiber;
 	VALUE io;
 	
+	// Whether the descriptor is used as a socket, otherwise its original flags:
+	int socket;
 	int flags;
 	
 	int descriptor;
@@ -618,7 +865,19 @@ VALUE io_read_loop(VALUE _arguments) {
 	
 	size_t maximum_size = arguments->size;
 	while (maximum_size) {
-		ssize_t result = read(arguments->descriptor, (char*)arguments->base+total, maximum_size);
+		ssize_t result;
+		
+		if (arguments->socket) {
+			result = recv(arguments->descriptor, (char*)arguments->base+total, maximum_size, MSG_DONTWAIT);
+			
+			if (result == -1 && errno == ENOTSOCK) {
+				arguments->socket = 0;
+				arguments->flags = IO_Event_Selector_EPoll_socket_fallback(arguments->self, arguments->io, arguments->descriptor);
+				continue;
+			}
+		} else {
+			result = read(arguments->descriptor, (char*)arguments->base+total, maximum_size);
+		}
 		
 		if (result > 0) {
 			total += result;
@@ -628,7 +887,7 @@ VALUE io_read_loop(VALUE _arguments) {
 		} else if (result == 0) {
 			break;
 		} else if (length > 0 && IO_Event_try_again(errno)) {
-			IO_Event_Selector_EPoll_io_wait(arguments->self, arguments->fiber, arguments->io, RB_INT2NUM(IO_EVENT_READABLE));
+			IO_Event_Selector_EPoll_io_wait_again(arguments->self, arguments->fiber, arguments->io, IO_EVENT_READABLE);
 		} else {
 			return rb_fiber_scheduler_io_result(-1, errno);
 		}
@@ -641,7 +900,9 @@ static
 VALUE io_read_ensure(VALUE _arguments) {
 	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
 	
-	IO_Event_Selector_nonblock_restore(arguments->descriptor, arguments->flags);
+	if (!arguments->socket) {
+		IO_Event_Selector_nonblock_restore(arguments->descriptor, arguments->flags);
+	}
 	
 	return Qnil;
 }
@@ -664,13 +925,15 @@ VALUE IO_Event_Selector_EPoll_io_read(VALUE self, VALUE fiber, VALUE io, VALUE b
 	size -= offset;
 	
 	int descriptor = IO_Event_Selector_io_descriptor(io);
+	int socket = IO_Event_Selector_EPoll_socket_p(self, io, descriptor);
 	
 	struct io_read_arguments io_read_arguments = {
 		.self = self,
 		.fiber = fiber,
 		.io = io,
 		
-		.flags = IO_Event_Selector_nonblock_set(descriptor),
+		.socket = socket,
+		.flags = socket ? -1 : IO_Event_Selector_nonblock_set(descriptor),
 		.descriptor = descriptor,
 		.base = base,
 		.size = size,
@@ -700,6 +963,8 @@ struct io_write_arguments {
 	VALUE fiber;
 	VALUE io;
 	
+	// Whether the descriptor is used as a socket, otherwise its original flags:
+	int socket;
 	int flags;
 	
 	int descriptor;
@@ -721,7 +986,19 @@ VALUE io_write_loop(VALUE _arguments) {
 	
 	size_t maximum_size = arguments->size;
 	while (maximum_size) {
-		ssize_t result = write(arguments->descriptor, (char*)arguments->base+total, maximum_size);
+		ssize_t result;
+		
+		if (arguments->socket) {
+			result = send(arguments->descriptor, (char*)arguments->base+total, maximum_size, MSG_DONTWAIT);
+			
+			if (result == -1 && errno == ENOTSOCK) {
+				arguments->socket = 0;
+				arguments->flags = IO_Event_Selector_EPoll_socket_fallback(arguments->self, arguments->io, arguments->descriptor);
+				continue;
+			}
+		} else {
+			result = write(arguments->descriptor, (char*)arguments->base+total, maximum_size);
+		}
 		
 		if (result > 0) {
 			total += result;
@@ -731,7 +1008,7 @@ VALUE io_write_loop(VALUE _arguments) {
 		} else if (result == 0) {
 			break;
 		} else if (length > 0 && IO_Event_try_again(errno)) {
-			IO_Event_Selector_EPoll_io_wait(arguments->self, arguments->fiber, arguments->io, RB_INT2NUM(IO_EVENT_WRITABLE));
+			IO_Event_Selector_EPoll_io_wait_again(arguments->self, arguments->fiber, arguments->io, IO_EVENT_WRITABLE);
 		} else {
 			return rb_fiber_scheduler_io_result(-1, errno);
 		}
@@ -744,7 +1021,9 @@ static
 VALUE io_write_ensure(VALUE _arguments) {
 	struct io_write_arguments *arguments = (struct io_write_arguments *)_arguments;
 	
-	IO_Event_Selector_nonblock_restore(arguments->descriptor, arguments->flags);
+	if (!arguments->socket) {
+		IO_Event_Selector_nonblock_restore(arguments->descriptor, arguments->flags);
+	}
 	
 	return Qnil;
 };
@@ -771,13 +1050,15 @@ VALUE IO_Event_Selector_EPoll_io_write(VALUE self, VALUE fiber, VALUE io, VALUE
 	size -= offset;
 	
 	int descriptor = IO_Event_Selector_io_descriptor(io);
+	int socket = IO_Event_Selector_EPoll_socket_p(self, io, descriptor);
 	
 	struct io_write_arguments io_write_arguments = {
 		.self = self,
 		.fiber = fiber,
 		.io = io,
 		
-		.flags = IO_Event_Selector_nonblock_set(descriptor),
+		.socket = socket,
+		.flags = socket ? -1 : IO_Event_Selector_nonblock_set(descriptor),
 		.descriptor = descriptor,
 		.base = base,
 		.size = size,
@@ -802,6 +1083,523 @@ VALUE IO_Event_Selector_EPoll_io_write_compatible(int argc, VALUE *argv, VALUE s
 	return IO_Event_Selector_EPoll_io_write(self, argv[0], argv[1], argv[2], argv[3], _offset);
 }
 
+struct io_vector_arguments {
+	VALUE self;
+	VALUE fiber;
+	VALUE io;
+	
+	// Whether the descriptor is used as a socket, otherwise its original flags:
+	int socket;
+	int flags;
+	
+	int descriptor;
+	
+	// The remaining buffer regions, advanced after each partial transfer.
+	struct iovec *iovecs;
+	int count;
+	
+	// Temporary storage for the iovecs, if they were too big for the stack.
+	VALUE storage;
+};
+
+static
+VALUE io_readv_loop(VALUE _arguments) {
+	struct io_vector_arguments *arguments = (struct io_vector_arguments *)_arguments;
+	
+	while (arguments->count) {
+		ssize_t result;
+		
+		if (arguments->socket) {
+			struct msghdr message = {.msg_iov = arguments->iovecs, .msg_iovlen = arguments->count};
+			result = recvmsg(arguments->descriptor, &message, MSG_DONTWAIT);
+			
+			if (result == -1 && errno == ENOTSOCK) {
+				arguments->socket = 0;
+				arguments->flags = IO_Event_Selector_EPoll_socket_fallback(arguments->self, arguments->io, arguments->descriptor);
+				continue;
+			}
+		} else {
+			result = readv(arguments->descriptor, arguments->iovecs, arguments->count);
+		}
+		
+		if (result >= 0) {
+			return rb_fiber_scheduler_io_result(result, 0);
+		} else if (IO_Event_try_again(errno)) {
+			IO_Event_Selector_EPoll_io_wait_again(arguments->self, arguments->fiber, arguments->io, IO_EVENT_READABLE);
+		} else {
+			return rb_fiber_scheduler_io_result(-1, errno);
+		}
+	}
+	
+	return rb_fiber_scheduler_io_result(0, 0);
+}
+
+static
+VALUE io_writev_loop(VALUE _arguments) {
+	struct io_vector_arguments *arguments = (struct io_vector_arguments *)_arguments;
+	
+	size_t total = 0;
+	
+	while (arguments->count) {
+		ssize_t result;
+		
+		if (arguments->socket) {
+			struct msghdr message = {.msg_iov = arguments->iovecs, .msg_iovlen = arguments->count};
+			result = sendmsg(arguments->descriptor, &message, MSG_DONTWAIT);
+			
+			if (result == -1 && errno == ENOTSOCK) {
+				arguments->socket = 0;
+				arguments->flags = IO_Event_Selector_EPoll_socket_fallback(arguments->self, arguments->io, arguments->descriptor);
+				continue;
+			}
+		} else {
+			result = writev(arguments->descriptor, arguments->iovecs, arguments->count);
+		}
+		
+		if (result > 0) {
+			total += result;
+			IO_Event_Selector_iovec_advance(&arguments->iovecs, &arguments->count, result);
+		} else if (result == 0) {
+			break;
+		} else if (IO_Event_try_again(errno)) {
+			IO_Event_Selector_EPoll_io_wait_again(arguments->self, arguments->fiber, arguments->io, IO_EVENT_WRITABLE);
+		} else {
+			return rb_fiber_scheduler_io_result(-1, errno);
+		}
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+static
+VALUE io_vector_ensure(VALUE _arguments) {
+	struct io_vector_arguments *arguments = (struct io_vector_arguments *)_arguments;
+	
+	if (!arguments->socket) {
+		IO_Event_Selector_nonblock_restore(arguments->descriptor, arguments->flags);
+	}
+	
+	ALLOCV_END(arguments->storage);
+	
+	return Qnil;
+}
+
+static
+VALUE io_vector(VALUE self, VALUE fiber, VALUE io, VALUE buffers, int writable, VALUE (*loop)(VALUE)) {
+	int count = IO_Event_Selector_iovec_count(buffers);
+	
+	VALUE storage = 0;
+	struct iovec *iovecs = ALLOCV_N(struct iovec, storage, count);
+	IO_Event_Selector_iovec_fill(buffers, iovecs, count, writable);
+	
+	int descriptor = IO_Event_Selector_io_descriptor(io);
+	int socket = IO_Event_Selector_EPoll_socket_p(self, io, descriptor);
+	
+	struct io_vector_arguments io_vector_arguments = {
+		.self = self,
+		.fiber = fiber,
+		.io = io,
+		
+		.socket = socket,
+		.flags = socket ? -1 : IO_Event_Selector_nonblock_set(descriptor),
+		.descriptor = descriptor,
+		.iovecs = iovecs,
+		.count = count,
+		.storage = storage,
+	};
+	
+	RB_OBJ_WRITTEN(self, Qundef, fiber);
+	
+	return rb_ensure(loop, (VALUE)&io_vector_arguments, io_vector_ensure, (VALUE)&io_vector_arguments);
+}
+
+// Read into the given buffers, in order, using a single `readv` once the IO is readable. Returns the number of bytes read, which is zero at end of file.
+VALUE IO_Event_Selector_EPoll_io_readv(VALUE self, VALUE fiber, VALUE io, VALUE buffers) {
+	return io_vector(self, fiber, io, buffers, 1, io_readv_loop);
+}
+
+// Write all of the given buffers, in order, using `writev`. Returns the total number of bytes written.
+VALUE IO_Event_Selector_EPoll_io_writev(VALUE self, VALUE fiber, VALUE io, VALUE buffers) {
+	return io_vector(self, fiber, io, buffers, 0, io_writev_loop);
+}
+
+#pragma mark - IO#splice
+
+struct io_splice_arguments {
+	VALUE self;
+	VALUE fiber;
+	VALUE to;
+	
+	int flags;
+	
+	int input;
+	int output;
+	
+	size_t length;
+};
+
+static
+VALUE io_splice_loop(VALUE _arguments) {
+	struct io_splice_arguments *arguments = (struct io_splice_arguments *)_arguments;
+	
+	size_t total = 0;
+	
+	while (total < arguments->length) {
+		ssize_t result = sendfile(arguments->output, arguments->input, NULL, arguments->length - total);
+		
+		if (result > 0) {
+			total += result;
+		} else if (result == 0) {
+			break;
+		} else if (IO_Event_try_again(errno)) {
+			IO_Event_Selector_EPoll_io_wait_again(arguments->self, arguments->fiber, arguments->to, IO_EVENT_WRITABLE);
+		} else if (total) {
+			// Report the data which was already transferred, the error will occur again on the next call:
+			break;
+		} else {
+			return rb_fiber_scheduler_io_result(-1, errno);
+		}
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+static
+VALUE io_splice_ensure(VALUE _arguments) {
+	struct io_splice_arguments *arguments = (struct io_splice_arguments *)_arguments;
+	
+	IO_Event_Selector_nonblock_restore(arguments->output, arguments->flags);
+	
+	return Qnil;
+}
+
+// Transfer up to `length` bytes from the current position of `from` to `to` using `sendfile`, without copying the data through user space. `from` must support `mmap`-like operations, e.g. a regular file. Stops early at end of file.
+//
+// Returns the number of bytes transferred, or a negated errno if an error occurred before any data was transferred.
+VALUE IO_Event_Selector_EPoll_io_splice(VALUE self, VALUE fiber, VALUE from, VALUE to, VALUE _length) {
+	int output = IO_Event_Selector_io_descriptor(to);
+	
+	struct io_splice_arguments io_splice_arguments = {
+		.self = self,
+		.fiber = fiber,
+		.to = to,
+		
+		.input = IO_Event_Selector_io_descriptor(from),
+		.flags = IO_Event_Selector_nonblock_set(output),
+		.output = output,
+		.length = NUM2SIZET(_length),
+	};
+	
+	RB_OBJ_WRITTEN(self, Qundef, fiber);
+	
+	return rb_ensure(io_splice_loop, (VALUE)&io_splice_arguments, io_splice_ensure, (VALUE)&io_splice_arguments);
+}
+
+#endif
+
+// File operations can't be waited on using epoll, so they are performed without the GVL. On Ruby 3.4+ (which provides `RB_NOGVL_OFFLOAD_SAFE`), if the fiber scheduler implements `blocking_operation_wait` (e.g. using `IO::Event::WorkerPool`), they are offloaded to a worker thread and only the calling fiber blocks. Otherwise, they block the event loop's thread, although other threads can run in the meantime:
+#ifdef RB_NOGVL_OFFLOAD_SAFE
+#define IO_EVENT_SELECTOR_EPOLL_NOGVL_FLAGS RB_NOGVL_OFFLOAD_SAFE
+#else
+#define IO_EVENT_SELECTOR_EPOLL_NOGVL_FLAGS 0
+#endif
+
+struct io_file_arguments {
+	int descriptor;
+	const char *path;
+	int flags;
+	mode_t mode;
+	off_t offset;
+	off_t length;
+	struct stat *stat;
+	void *base;
+	size_t size;
+	
+	ssize_t result;
+	int error;
+};
+
+static
+ssize_t io_file(void *(*function)(void *), struct io_file_arguments *arguments) {
+	arguments->result = -1;
+	arguments->error = EINTR;
+	
+	rb_nogvl(function, arguments, RUBY_UBF_IO, NULL, IO_EVENT_SELECTOR_EPOLL_NOGVL_FLAGS);
+	
+	if (arguments->result < 0) {
+		return -arguments->error;
+	}
+	
+	return arguments->result;
+}
+
+static
+void * io_open_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	arguments->result = open(arguments->path, arguments->flags, arguments->mode);
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+// Open the file at the given path, like `IO.sysopen`. The descriptor is always opened with `O_CLOEXEC`.
+//
+// Returns the file descriptor as an Integer, or a negated errno.
+VALUE IO_Event_Selector_EPoll_io_open(VALUE self, VALUE fiber, VALUE path, VALUE flags, VALUE mode) {
+	path = rb_get_path(path);
+	
+	struct io_file_arguments arguments = {
+		.path = StringValueCStr(path),
+		.flags = NUM2INT(flags) | O_CLOEXEC,
+		.mode = NUM2UINT(mode),
+	};
+	
+	int result = io_file(io_open_without_gvl, &arguments);
+	RB_GC_GUARD(path);
+	
+	if (result >= 0) {
+		rb_update_max_fd(result);
+	}
+	
+	return RB_INT2NUM(result);
+}
+
+static
+void * io_stat_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	arguments->result = stat(arguments->path, arguments->stat);
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+// Get the status of the file at the given path, following symbolic links, like `File.stat`.
+//
+// Returns a `File::Stat`, or a negated errno.
+VALUE IO_Event_Selector_EPoll_io_stat(VALUE self, VALUE fiber, VALUE path) {
+	path = rb_get_path(path);
+	
+	struct stat stat;
+	
+	struct io_file_arguments arguments = {
+		.path = StringValueCStr(path),
+		.stat = &stat,
+	};
+	
+	int result = io_file(io_stat_without_gvl, &arguments);
+	RB_GC_GUARD(path);
+	
+	if (result < 0) {
+		return RB_INT2NUM(result);
+	}
+	
+	return rb_stat_new(&stat);
+}
+
+static
+void * io_fsync_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	if (arguments->flags) {
+		arguments->result = fdatasync(arguments->descriptor);
+	} else {
+		arguments->result = fsync(arguments->descriptor);
+	}
+	
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+// `io_fsync(fiber, io, data = false)`: Flush the file's data and metadata to the storage device. If `data` is true, only the metadata required to read the data back is flushed, like `fdatasync`.
+//
+// Returns 0, or a negated errno.
+VALUE IO_Event_Selector_EPoll_io_fsync(int argc, VALUE *argv, VALUE self) {
+	rb_check_arity(argc, 2, 3);
+	
+	struct io_file_arguments arguments = {
+		.descriptor = IO_Event_Selector_io_descriptor(argv[1]),
+		.flags = argc == 3 && RTEST(argv[2]),
+	};
+	
+	return RB_INT2NUM(io_file(io_fsync_without_gvl, &arguments));
+}
+
+static
+void * io_fallocate_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	arguments->result = fallocate(arguments->descriptor, arguments->mode, arguments->offset, arguments->length);
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+// Allocate disk space for the given region of the file, extending it if required, like `posix_fallocate`.
+//
+// Returns 0, or a negated errno.
+VALUE IO_Event_Selector_EPoll_io_fallocate(VALUE self, VALUE fiber, VALUE io, VALUE offset, VALUE length) {
+	struct io_file_arguments arguments = {
+		.descriptor = IO_Event_Selector_io_descriptor(io),
+		.mode = 0,
+		.offset = NUM2OFFT(offset),
+		.length = NUM2OFFT(length),
+	};
+	
+	return RB_INT2NUM(io_file(io_fallocate_without_gvl, &arguments));
+}
+
+#ifdef HAVE_RUBY_IO_BUFFER_H
+
+#pragma mark - IO#pread/IO#pwrite
+
+#if defined(HAVE_PREADV2) && defined(HAVE_PWRITEV2) && defined(RWF_NOWAIT)
+#define IO_EVENT_SELECTOR_EPOLL_RWF_NOWAIT
+#endif
+
+static
+void * io_pread_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	arguments->result = pread(arguments->descriptor, arguments->base, arguments->size, arguments->offset);
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+static
+void * io_pwrite_without_gvl(void *_arguments) {
+	struct io_file_arguments *arguments = _arguments;
+	
+	arguments->result = pwrite(arguments->descriptor, arguments->base, arguments->size, arguments->offset);
+	arguments->error = errno;
+	
+	return NULL;
+}
+
+// Regular files are always reported as ready by epoll, so positional reads and writes are first attempted inline using `RWF_NOWAIT`, which succeeds if the data is in the page cache. Otherwise (including on kernels and file systems which don't support the flag), they are performed without the GVL like other file operations, so a slow disk only blocks the calling fiber if they can be offloaded (see above), and the whole event loop otherwise.
+static
+ssize_t io_pread_nowait(struct io_file_arguments *arguments) {
+#ifdef IO_EVENT_SELECTOR_EPOLL_RWF_NOWAIT
+	struct iovec iovec = {.iov_base = arguments->base, .iov_len = arguments->size};
+	
+	ssize_t result = preadv2(arguments->descriptor, &iovec, 1, arguments->offset, RWF_NOWAIT);
+	if (result >= 0) return result;
+#endif
+	
+	return io_file(io_pread_without_gvl, arguments);
+}
+
+static
+ssize_t io_pwrite_nowait(struct io_file_arguments *arguments) {
+#ifdef IO_EVENT_SELECTOR_EPOLL_RWF_NOWAIT
+	struct iovec iovec = {.iov_base = arguments->base, .iov_len = arguments->size};
+	
+	ssize_t result = pwritev2(arguments->descriptor, &iovec, 1, arguments->offset, RWF_NOWAIT);
+	if (result >= 0) return result;
+#endif
+	
+	return io_file(io_pwrite_without_gvl, arguments);
+}
+
+VALUE IO_Event_Selector_EPoll_io_pread(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+	void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	off_t from = NUM2OFFT(_from);
+	
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	struct io_file_arguments arguments = {
+		.descriptor = IO_Event_Selector_io_descriptor(io),
+	};
+	
+	size_t maximum_size = size - offset;
+	while (maximum_size) {
+		arguments.base = (char*)base + offset;
+		arguments.size = maximum_size;
+		arguments.offset = from;
+		
+		ssize_t result = io_pread_nowait(&arguments);
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			from += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+VALUE IO_Event_Selector_EPoll_io_pwrite(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+	const void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_reading(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	off_t from = NUM2OFFT(_from);
+	
+	if (length > size) {
+		rb_raise(rb_eRuntimeError, "Length exceeds size of buffer!");
+	}
+	
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	struct io_file_arguments arguments = {
+		.descriptor = IO_Event_Selector_io_descriptor(io),
+	};
+	
+	size_t maximum_size = size - offset;
+	while (maximum_size) {
+		arguments.base = (char*)base + offset;
+		arguments.size = maximum_size;
+		arguments.offset = from;
+		
+		ssize_t result = io_pwrite_nowait(&arguments);
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			from += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
 #endif
 
 static
@@ -848,7 +1646,7 @@ struct select_arguments {
 	int count;
 	int result;
 	int error;
-	struct epoll_event events[EPOLL_MAX_EVENTS];
+	struct epoll_event *events;
 	
 	struct timespec * timeout;
 	struct timespec storage;
@@ -903,6 +1701,21 @@ void * select_internal(void *_arguments) {
 	return NULL;
 }
 
+static
+void select_record_batch(struct select_arguments *arguments) {
+	struct IO_Event_Selector_EPoll *selector = arguments->selector;
+	
+	if (arguments->result > 0) {
+		selector->batches += 1;
+		selector->batch_events += arguments->result;
+		selector->batch_capacity += arguments->count;
+		
+		if (arguments->result == arguments->count) {
+			selector->full_batches += 1;
+		}
+	}
+}
+
 static
 int select_internal_without_gvl(struct select_arguments *arguments) {
 	arguments->result = -1;
@@ -917,6 +1730,8 @@ int select_internal_without_gvl(struct select_arguments *arguments) {
 		}
 	}
 	
+	select_record_batch(arguments);
+	
 	return arguments->result;
 }
 
@@ -932,6 +1747,8 @@ int select_internal_with_gvl(struct select_arguments *arguments) {
 		}
 	}
 	
+	select_record_batch(arguments);
+	
 	return arguments->result;
 }
 
@@ -950,6 +1767,9 @@ int IO_Event_Selector_EPoll_handle(struct IO_Event_Selector_EPoll *selector, con
 	// Reset the events back to 0 so that we can re-arm if necessary:
 	epoll_descriptor->waiting_events = 0;
 	
+	// The union of events which were delivered to waiting fibers:
+	enum IO_Event matched_events = 0;
+	
 	if (DEBUG) fprintf(stderr, "IO_Event_Selector_EPoll_handle: descriptor=%d, ready_events=%d epoll_descriptor=%p\n", descriptor, ready_events, epoll_descriptor);
 	
 	// It's possible (but unlikely) that the address of list will changing during iteration.
@@ -964,6 +1784,8 @@ int IO_Event_Selector_EPoll_handle(struct IO_Event_Selector_EPoll *selector, con
 		if (DEBUG) fprintf(stderr, "IO_Event_Selector_EPoll_handle: descriptor=%d, ready_events=%d, waiting_events=%d, matching_events=%d\n", descriptor, ready_events, waiting->events, matching_events);
 		
 		if (matching_events) {
+			matched_events |= matching_events;
+			
 			IO_Event_List_append(node, saved);
 			
 			// Resume the fiber:
@@ -979,20 +1801,58 @@ int IO_Event_Selector_EPoll_handle(struct IO_Event_Selector_EPoll *selector, con
 		}
 	}
 	
+	// Cache whatever no fiber was waiting for, so that a later `io_wait` can return without waiting for the kernel to report it again:
+	epoll_descriptor->ready |= event->events & ~epoll_flags_consumed_by_events(matched_events, epoll_descriptor->edge_triggered);
+	
+	if (epoll_descriptor->edge_triggered) {
+		// Resumed fibers which wait again have already done so, so anything else is no longer in use:
+		IO_Event_Selector_EPoll_Descriptor_release(selector, epoll_descriptor);
+		
+		return 0;
+	}
+	
 	return IO_Event_Selector_EPoll_Descriptor_update(selector, epoll_descriptor->io, descriptor, epoll_descriptor);
 }
 
+// Poll for events without blocking, used while spinning before a blocking wait.
+static
+int select_spin_poll(void *_arguments) {
+	struct select_arguments *arguments = (struct select_arguments *)_arguments;
+	
+	struct timespec *timeout = arguments->timeout;
+	struct timespec nonblocking = {0, 0};
+	
+	arguments->timeout = &nonblocking;
+	int result = select_internal_with_gvl(arguments);
+	arguments->timeout = timeout;
+	
+	return result;
+}
+
 static
 VALUE select_handle_events(VALUE _arguments)
 {
 	struct select_arguments *arguments = (struct select_arguments *)_arguments;
 	struct IO_Event_Selector_EPoll *selector = arguments->selector;
 	
+	// The time at which the events were returned, to measure how long each one waits to be handled:
+	struct timespec ready_time;
+	int latency_tracking = selector->backend.latency_tracking;
+	if (latency_tracking) {
+		IO_Event_Time_current(&ready_time);
+	}
+	
 	for (int i = 0; i < arguments->result; i += 1) {
 		const struct epoll_event *event = &arguments->events[i];
 		if (DEBUG) fprintf(stderr, "-> fd=%d events=%d\n", event->data.fd, event->events);
 		
 		if (event->data.fd >= 0) {
+			selector->backend.statistics.events += 1;
+			
+			if (latency_tracking) {
+				IO_Event_Selector_latency_record(&selector->backend, &ready_time);
+			}
+			
 			IO_Event_Selector_EPoll_handle(selector, event, &arguments->saved);
 		} else {
 			IO_Event_Interrupt_clear(&selector->interrupt);
@@ -1020,11 +1880,14 @@ VALUE IO_Event_Selector_EPoll_select(VALUE self, VALUE duration) {
 	selector->idle_duration.tv_sec = 0;
 	selector->idle_duration.tv_nsec = 0;
 	
+	selector->backend.statistics.selects += 1;
+	
 	int ready = IO_Event_Selector_ready_flush(&selector->backend);
 	
 	struct select_arguments arguments = {
 		.selector = selector,
-		.count = EPOLL_MAX_EVENTS,
+		.events = selector->events,
+		.count = selector->max_events,
 		.result = 0,
 		.storage = {
 			.tv_sec = 0,
@@ -1047,6 +1910,13 @@ VALUE IO_Event_Selector_EPoll_select(VALUE self, VALUE duration) {
 		arguments.timeout = make_timeout(duration, &arguments.storage);
 		
 		if (select_blocking_allowed(arguments.timeout)) {
+			// Keep polling for a short while, as events which arrive soon are cheaper to pick up without releasing the GVL and blocking:
+			result = IO_Event_Selector_spin_wait(&selector->backend, arguments.timeout, select_spin_poll, &arguments);
+		}
+		
+		if (!result && select_blocking_allowed(arguments.timeout)) {
+			selector->backend.statistics.blocking_waits += 1;
+			
 			struct timespec start_time;
 			IO_Event_Time_current(&start_time);
 			
@@ -1060,18 +1930,91 @@ VALUE IO_Event_Selector_EPoll_select(VALUE self, VALUE duration) {
 	}
 	
 	if (result) {
-		return rb_ensure(select_handle_events, (VALUE)&arguments, select_handle_events_ensure, (VALUE)&arguments);
+		VALUE value = rb_ensure(select_handle_events, (VALUE)&arguments, select_handle_events_ensure, (VALUE)&arguments);
+		
+		// A full batch means more events may be pending, so grow the buffer to drain them with fewer calls. This must happen after the events were handled, as they are stored in the buffer:
+		if (result == arguments.count && selector->max_events < selector->max_events_limit) {
+			int max_events = selector->max_events * 2;
+			if (max_events > selector->max_events_limit) max_events = selector->max_events_limit;
+			
+			REALLOC_N(selector->events, struct epoll_event, max_events);
+			selector->max_events = max_events;
+		}
+		
+		return value;
 	} else {
 		return RB_INT2NUM(0);
 	}
 }
 
+// Runtime statistics of the selector. In addition to the common counters, this reports the batches of events returned by `epoll_wait`, whose average fill ratio is `batch_events / batch_capacity` (only calls which returned at least one event are counted), and the number of `epoll_ctl` calls.
+VALUE IO_Event_Selector_EPoll_statistics(VALUE self) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	VALUE statistics = IO_Event_Selector_statistics(&selector->backend, rb_hash_new());
+	
+	rb_hash_aset(statistics, ID2SYM(rb_intern("max_events")), RB_INT2NUM(selector->max_events));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("batches")), SIZET2NUM(selector->batches));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("batch_events")), SIZET2NUM(selector->batch_events));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("batch_capacity")), SIZET2NUM(selector->batch_capacity));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("full_batches")), SIZET2NUM(selector->full_batches));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("epoll_ctls")), SIZET2NUM(selector->epoll_ctls));
+	
+	return statistics;
+}
+
+VALUE IO_Event_Selector_EPoll_spin(VALUE self) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	return IO_Event_Selector_spin(&selector->backend);
+}
+
+// Keep polling for events for up to the given number of seconds before releasing the GVL and blocking, which avoids a context switch when events arrive soon after the selector runs out of work. `statistics` reports how often spinning found events.
+VALUE IO_Event_Selector_EPoll_spin_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	IO_Event_Selector_spin_set(&selector->backend, value);
+	
+	return value;
+}
+
+VALUE IO_Event_Selector_EPoll_latency_tracking(VALUE self) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	return selector->backend.latency_tracking ? Qtrue : Qfalse;
+}
+
+// Record how long fibers wait between becoming ready (being pushed to the ready queue, or their event being returned by the kernel) and being resumed. Enabling it clears the histogram.
+VALUE IO_Event_Selector_EPoll_latency_tracking_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	IO_Event_Selector_latency_tracking_set(&selector->backend, value);
+	
+	return value;
+}
+
+// A log2 histogram of scheduling latency, where index `i` counts delays of at least `2**(i-1)` and less than `2**i` nanoseconds, or `nil` if latency tracking is disabled.
+VALUE IO_Event_Selector_EPoll_latency_histogram(VALUE self) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	return IO_Event_Selector_latency_histogram(&selector->backend);
+}
+
 VALUE IO_Event_Selector_EPoll_wakeup(VALUE self) {
 	struct IO_Event_Selector_EPoll *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
 	
+	selector->backend.statistics.wakeups += 1;
+	
 	// If we are blocking, we can schedule a nop event to wake up the selector:
 	if (selector->backend.blocked) {
+		selector->backend.statistics.wakeup_signals += 1;
 		IO_Event_Interrupt_signal(&selector->interrupt);
 		
 		return Qtrue;
@@ -1080,6 +2023,18 @@ VALUE IO_Event_Selector_EPoll_wakeup(VALUE self) {
 	return Qfalse;
 }
 
+// Append the given fiber to the ready queue from any thread, e.g. to hand work from a background thread to the event loop. The event loop is woken up if it is blocked, once for all the fibers pushed before it runs again.
+VALUE IO_Event_Selector_EPoll_push_remote(VALUE self, VALUE fiber) {
+	struct IO_Event_Selector_EPoll *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_EPoll, &IO_Event_Selector_EPoll_Type, selector);
+	
+	if (IO_Event_Selector_remote_push(&selector->backend, fiber)) {
+		IO_Event_Selector_EPoll_wakeup(self);
+	}
+	
+	return Qnil;
+}
+
 static int IO_Event_Selector_EPoll_supported_p(void) {
 	int fd = epoll_create1(EPOLL_CLOEXEC);
 	
@@ -1102,7 +2057,9 @@ void Init_IO_Event_Selector_EPoll(VALUE IO_Event_Selector) {
 	VALUE IO_Event_Selector_EPoll = rb_define_class_under(IO_Event_Selector, "EPoll", rb_cObject);
 	
 	rb_define_alloc_func(IO_Event_Selector_EPoll, IO_Event_Selector_EPoll_allocate);
-	rb_define_method(IO_Event_Selector_EPoll, "initialize", IO_Event_Selector_EPoll_initialize, 1);
+	id_max_events = rb_intern("max_events");
+	
+	rb_define_method(IO_Event_Selector_EPoll, "initialize", IO_Event_Selector_EPoll_initialize, -1);
 	
 	rb_define_method(IO_Event_Selector_EPoll, "loop", IO_Event_Selector_EPoll_loop, 0);
 	rb_define_method(IO_Event_Selector_EPoll, "idle_duration", IO_Event_Selector_EPoll_idle_duration, 0);
@@ -1111,25 +2068,45 @@ void Init_IO_Event_Selector_EPoll(VALUE IO_Event_Selector) {
 	rb_define_method(IO_Event_Selector_EPoll, "resume", IO_Event_Selector_EPoll_resume, -1);
 	rb_define_method(IO_Event_Selector_EPoll, "yield", IO_Event_Selector_EPoll_yield, 0);
 	rb_define_method(IO_Event_Selector_EPoll, "push", IO_Event_Selector_EPoll_push, 1);
+	rb_define_method(IO_Event_Selector_EPoll, "push_remote", IO_Event_Selector_EPoll_push_remote, 1);
 	rb_define_method(IO_Event_Selector_EPoll, "raise", IO_Event_Selector_EPoll_raise, -1);
 	
 	rb_define_method(IO_Event_Selector_EPoll, "ready?", IO_Event_Selector_EPoll_ready_p, 0);
 	
 	rb_define_method(IO_Event_Selector_EPoll, "select", IO_Event_Selector_EPoll_select, 1);
 	rb_define_method(IO_Event_Selector_EPoll, "wakeup", IO_Event_Selector_EPoll_wakeup, 0);
+	rb_define_method(IO_Event_Selector_EPoll, "statistics", IO_Event_Selector_EPoll_statistics, 0);
+	rb_define_method(IO_Event_Selector_EPoll, "spin", IO_Event_Selector_EPoll_spin, 0);
+	rb_define_method(IO_Event_Selector_EPoll, "spin=", IO_Event_Selector_EPoll_spin_set, 1);
+	rb_define_method(IO_Event_Selector_EPoll, "latency_tracking", IO_Event_Selector_EPoll_latency_tracking, 0);
+	rb_define_method(IO_Event_Selector_EPoll, "latency_tracking=", IO_Event_Selector_EPoll_latency_tracking_set, 1);
+	rb_define_method(IO_Event_Selector_EPoll, "latency_histogram", IO_Event_Selector_EPoll_latency_histogram, 0);
 	rb_define_method(IO_Event_Selector_EPoll, "close", IO_Event_Selector_EPoll_close, 0);
 	rb_define_method(IO_Event_Selector_EPoll, "closed?", IO_Event_Selector_EPoll_closed_p, 0);
 	
 	rb_define_method(IO_Event_Selector_EPoll, "io_wait", IO_Event_Selector_EPoll_io_wait, 3);
 	
+	rb_define_method(IO_Event_Selector_EPoll, "edge_triggered", IO_Event_Selector_EPoll_edge_triggered, 0);
+	rb_define_method(IO_Event_Selector_EPoll, "edge_triggered=", IO_Event_Selector_EPoll_edge_triggered_set, 1);
+	
 #ifdef HAVE_RUBY_IO_BUFFER_H
 	rb_define_method(IO_Event_Selector_EPoll, "io_read", IO_Event_Selector_EPoll_io_read_compatible, -1);
 	rb_define_method(IO_Event_Selector_EPoll, "io_write", IO_Event_Selector_EPoll_io_write_compatible, -1);
+	rb_define_method(IO_Event_Selector_EPoll, "io_readv", IO_Event_Selector_EPoll_io_readv, 3);
+	rb_define_method(IO_Event_Selector_EPoll, "io_writev", IO_Event_Selector_EPoll_io_writev, 3);
+	rb_define_method(IO_Event_Selector_EPoll, "io_splice", IO_Event_Selector_EPoll_io_splice, 4);
+	rb_define_method(IO_Event_Selector_EPoll, "io_pread", IO_Event_Selector_EPoll_io_pread, 6);
+	rb_define_method(IO_Event_Selector_EPoll, "io_pwrite", IO_Event_Selector_EPoll_io_pwrite, 6);
 #endif
 	
 	// Once compatibility isn't a concern, we can do this:
 	// rb_define_method(IO_Event_Selector_EPoll, "io_read", IO_Event_Selector_EPoll_io_read, 5);
 	// rb_define_method(IO_Event_Selector_EPoll, "io_write", IO_Event_Selector_EPoll_io_write, 5);
 	
+	rb_define_method(IO_Event_Selector_EPoll, "io_open", IO_Event_Selector_EPoll_io_open, 4);
+	rb_define_method(IO_Event_Selector_EPoll, "io_stat", IO_Event_Selector_EPoll_io_stat, 2);
+	rb_define_method(IO_Event_Selector_EPoll, "io_fsync", IO_Event_Selector_EPoll_io_fsync, -1);
+	rb_define_method(IO_Event_Selector_EPoll, "io_fallocate", IO_Event_Selector_EPoll_io_fallocate, 4);
+	
 	rb_define_method(IO_Event_Selector_EPoll, "process_wait", IO_Event_Selector_EPoll_process_wait, 3);
 }
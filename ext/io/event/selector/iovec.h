@@ -0,0 +1,72 @@
+// Released under the MIT License.
+// Copyright, 2026, by Samuel Williams.
+
+#pragma once
+
+#include <ruby.h>
+#include <ruby/io/buffer.h>
+
+#include <sys/uio.h>
+#include <limits.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+// Validate the given array of buffers, returning the number of buffers.
+static inline
+int IO_Event_Selector_iovec_count(VALUE buffers)
+{
+	Check_Type(buffers, T_ARRAY);
+	
+	long count = RARRAY_LEN(buffers);
+	
+	if (count > IOV_MAX) {
+		rb_raise(rb_eArgError, "Too many buffers (%ld > %d)!", count, IOV_MAX);
+	}
+	
+	return (int)count;
+}
+
+// Fill the given iovecs from the array of buffers, returning the total size. If `writable` is set, the buffers will be written to (e.g. by `readv`), otherwise they will be read from (e.g. by `writev`).
+static inline
+size_t IO_Event_Selector_iovec_fill(VALUE buffers, struct iovec *iovecs, int count, int writable)
+{
+	size_t total = 0;
+	
+	for (int i = 0; i < count; i += 1) {
+		VALUE buffer = RARRAY_AREF(buffers, i);
+		void *base;
+		size_t size;
+		
+		if (writable) {
+			rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+		} else {
+			const void *readable;
+			rb_io_buffer_get_bytes_for_reading(buffer, &readable, &size);
+			base = (void*)readable;
+		}
+		
+		iovecs[i].iov_base = base;
+		iovecs[i].iov_len = size;
+		total += size;
+	}
+	
+	return total;
+}
+
+// Consume the given number of bytes from the front of the iovecs, e.g. after a partial `writev`.
+static inline
+void IO_Event_Selector_iovec_advance(struct iovec **iovecs, int *count, size_t size)
+{
+	while (*count > 0 && size >= (*iovecs)->iov_len) {
+		size -= (*iovecs)->iov_len;
+		*iovecs += 1;
+		*count -= 1;
+	}
+	
+	if (*count > 0) {
+		(*iovecs)->iov_base = (char*)(*iovecs)->iov_base + size;
+		(*iovecs)->iov_len -= size;
+	}
+}
@@ -148,6 +148,7 @@ void IO_Event_Selector_KQueue_Type_free(void *_selector)
 	
 	close_internal(selector);
 	
+	IO_Event_Selector_free(&selector->backend);
 	IO_Event_Array_free(&selector->descriptors);
 	
 	xfree(selector);
@@ -425,7 +426,7 @@ VALUE IO_Event_Selector_KQueue_ready_p(VALUE self) {
 	struct IO_Event_Selector_KQueue *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
 	
-	return selector->backend.ready ? Qtrue : Qfalse;
+	return IO_Event_Selector_ready_p(&selector->backend) ? Qtrue : Qfalse;
 }
 
 struct process_wait_arguments {
@@ -530,6 +531,10 @@ static
 VALUE io_wait_ensure(VALUE _arguments) {
 	struct io_wait_arguments *arguments = (struct io_wait_arguments *)_arguments;
 	
+	if (!arguments->waiting->ready) {
+		arguments->selector->backend.statistics.cancellations += 1;
+	}
+	
 	IO_Event_Selector_KQueue_Waiting_cancel(arguments->waiting);
 	
 	return Qnil;
@@ -960,8 +965,21 @@ VALUE select_handle_events(VALUE _arguments)
 		}
 	}
 	
+	// The time at which the events were returned, to measure how long each one waits to be handled:
+	struct timespec ready_time;
+	int latency_tracking = selector->backend.latency_tracking;
+	if (latency_tracking) {
+		IO_Event_Time_current(&ready_time);
+	}
+	
 	for (int i = 0; i < arguments->result; i += 1) {
 		if (arguments->events[i].udata) {
+			selector->backend.statistics.events += 1;
+			
+			if (latency_tracking) {
+				IO_Event_Selector_latency_record(&selector->backend, &ready_time);
+			}
+			
 			struct IO_Event_Selector_KQueue_Descriptor *kqueue_descriptor = arguments->events[i].udata;
 			IO_Event_Selector_KQueue_handle(selector, arguments->events[i].ident, kqueue_descriptor, &arguments->saved);
 		} else {
@@ -991,6 +1009,8 @@ VALUE IO_Event_Selector_KQueue_select(VALUE self, VALUE duration) {
 	selector->idle_duration.tv_sec = 0;
 	selector->idle_duration.tv_nsec = 0;
 	
+	selector->backend.statistics.selects += 1;
+	
 	int ready = IO_Event_Selector_ready_flush(&selector->backend);
 	
 	struct select_arguments arguments = {
@@ -1026,6 +1046,8 @@ VALUE IO_Event_Selector_KQueue_select(VALUE self, VALUE duration) {
 		arguments.timeout = make_timeout(duration, &arguments.storage);
 		
 		if (select_blocking_allowed(arguments.timeout)) {
+			selector->backend.statistics.blocking_waits += 1;
+			
 			struct timespec start_time;
 			IO_Event_Time_current(&start_time);
 			
@@ -1045,11 +1067,40 @@ VALUE IO_Event_Selector_KQueue_select(VALUE self, VALUE duration) {
 	}
 }
 
+VALUE IO_Event_Selector_KQueue_latency_tracking(VALUE self) {
+	struct IO_Event_Selector_KQueue *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
+	
+	return selector->backend.latency_tracking ? Qtrue : Qfalse;
+}
+
+// Record how long fibers wait between becoming ready (being pushed to the ready queue, or their event being returned by the kernel) and being resumed. Enabling it clears the histogram.
+VALUE IO_Event_Selector_KQueue_latency_tracking_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_KQueue *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
+	
+	IO_Event_Selector_latency_tracking_set(&selector->backend, value);
+	
+	return value;
+}
+
+// A log2 histogram of scheduling latency, where index `i` counts delays of at least `2**(i-1)` and less than `2**i` nanoseconds, or `nil` if latency tracking is disabled.
+VALUE IO_Event_Selector_KQueue_latency_histogram(VALUE self) {
+	struct IO_Event_Selector_KQueue *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
+	
+	return IO_Event_Selector_latency_histogram(&selector->backend);
+}
+
 VALUE IO_Event_Selector_KQueue_wakeup(VALUE self) {
 	struct IO_Event_Selector_KQueue *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
 	
+	selector->backend.statistics.wakeups += 1;
+	
 	if (selector->backend.blocked) {
+		selector->backend.statistics.wakeup_signals += 1;
+		
 #ifdef IO_EVENT_SELECTOR_KQUEUE_USE_INTERRUPT
 		IO_Event_Interrupt_signal(&selector->interrupt);
 #else
@@ -1081,6 +1132,26 @@ VALUE IO_Event_Selector_KQueue_wakeup(VALUE self) {
 	return Qfalse;
 }
 
+// Append the given fiber to the ready queue from any thread, e.g. to hand work from a background thread to the event loop. The event loop is woken up if it is blocked, once for all the fibers pushed before it runs again.
+VALUE IO_Event_Selector_KQueue_push_remote(VALUE self, VALUE fiber) {
+	struct IO_Event_Selector_KQueue *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
+	
+	if (IO_Event_Selector_remote_push(&selector->backend, fiber)) {
+		IO_Event_Selector_KQueue_wakeup(self);
+	}
+	
+	return Qnil;
+}
+
+// Runtime statistics of the selector, see `IO_Event_Selector_Statistics`.
+VALUE IO_Event_Selector_KQueue_statistics(VALUE self) {
+	struct IO_Event_Selector_KQueue *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_KQueue, &IO_Event_Selector_KQueue_Type, selector);
+	
+	return IO_Event_Selector_statistics(&selector->backend, rb_hash_new());
+}
+
 
 static int IO_Event_Selector_KQueue_supported_p(void) {
 	int fd = kqueue();
@@ -1113,12 +1184,17 @@ void Init_IO_Event_Selector_KQueue(VALUE IO_Event_Selector) {
 	rb_define_method(IO_Event_Selector_KQueue, "resume", IO_Event_Selector_KQueue_resume, -1);
 	rb_define_method(IO_Event_Selector_KQueue, "yield", IO_Event_Selector_KQueue_yield, 0);
 	rb_define_method(IO_Event_Selector_KQueue, "push", IO_Event_Selector_KQueue_push, 1);
+	rb_define_method(IO_Event_Selector_KQueue, "push_remote", IO_Event_Selector_KQueue_push_remote, 1);
 	rb_define_method(IO_Event_Selector_KQueue, "raise", IO_Event_Selector_KQueue_raise, -1);
 	
 	rb_define_method(IO_Event_Selector_KQueue, "ready?", IO_Event_Selector_KQueue_ready_p, 0);
 	
 	rb_define_method(IO_Event_Selector_KQueue, "select", IO_Event_Selector_KQueue_select, 1);
 	rb_define_method(IO_Event_Selector_KQueue, "wakeup", IO_Event_Selector_KQueue_wakeup, 0);
+	rb_define_method(IO_Event_Selector_KQueue, "statistics", IO_Event_Selector_KQueue_statistics, 0);
+	rb_define_method(IO_Event_Selector_KQueue, "latency_tracking", IO_Event_Selector_KQueue_latency_tracking, 0);
+	rb_define_method(IO_Event_Selector_KQueue, "latency_tracking=", IO_Event_Selector_KQueue_latency_tracking_set, 1);
+	rb_define_method(IO_Event_Selector_KQueue, "latency_histogram", IO_Event_Selector_KQueue_latency_histogram, 0);
 	rb_define_method(IO_Event_Selector_KQueue, "close", IO_Event_Selector_KQueue_close, 0);
 	rb_define_method(IO_Event_Selector_KQueue, "closed?", IO_Event_Selector_KQueue_closed_p, 0);
 	
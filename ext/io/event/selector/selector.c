@@ -5,6 +5,7 @@
 
 #include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
 
 static const int DEBUG = 0;
 
@@ -34,7 +35,13 @@ static VALUE IO_Event_Selector_blocking_operation_fallback(VALUE callback_argume
 
 void IO_Event_Selector_blocking_operation(struct IO_Event_Selector *selector, void *(*function)(void *), void *data, rb_unblock_function_t *unblock_function, void *unblock_data) {
 	int state = 0;
-	selector->blocked = 1;
+	__atomic_store_n(&selector->blocked, 1, __ATOMIC_SEQ_CST);
+	
+	// A fiber pushed from another thread after the ready queue was flushed won't have signalled us, as we weren't blocked yet. Callers treat this like an interrupted wait:
+	if (__atomic_load_n(&selector->remote, __ATOMIC_SEQ_CST)) {
+		selector->blocked = 0;
+		return;
+	}
 	
 #ifdef RB_NOGVL_PENDING_INTR_FAIL
 	rb_nogvl(function, data, unblock_function, unblock_data, RB_NOGVL_INTR_FAIL | RB_NOGVL_PENDING_INTR_FAIL);
@@ -173,7 +180,138 @@ void IO_Event_Selector_initialize(struct IO_Event_Selector *backend, VALUE self,
 	
 	backend->waiting = NULL;
 	backend->ready = NULL;
+	backend->remote = NULL;
+	backend->pool = NULL;
+	backend->pool_size = 0;
 	backend->blocked = 0;
+	
+	backend->spin.tv_sec = 0;
+	backend->spin.tv_nsec = 0;
+	backend->statistics = (struct IO_Event_Selector_Statistics){0};
+	
+	backend->latency_tracking = 0;
+	memset(backend->latency, 0, sizeof(backend->latency));
+}
+
+VALUE IO_Event_Selector_statistics(struct IO_Event_Selector *backend, VALUE statistics) {
+	struct IO_Event_Selector_Statistics *counters = &backend->statistics;
+	
+	rb_hash_aset(statistics, ID2SYM(rb_intern("selects")), SIZET2NUM(counters->selects));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("blocking_waits")), SIZET2NUM(counters->blocking_waits));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("events")), SIZET2NUM(counters->events));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("ready_flushes")), SIZET2NUM(counters->ready_flushes));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("ready_resumes")), SIZET2NUM(counters->ready_resumes));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("wakeups")), SIZET2NUM(counters->wakeups));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("wakeup_signals")), SIZET2NUM(counters->wakeup_signals));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("cancellations")), SIZET2NUM(counters->cancellations));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("spins")), SIZET2NUM(counters->spins));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("spin_hits")), SIZET2NUM(counters->spin_hits));
+	
+	return statistics;
+}
+
+void IO_Event_Selector_latency_tracking_set(struct IO_Event_Selector *backend, VALUE value) {
+	if (RTEST(value) && !backend->latency_tracking) {
+		memset(backend->latency, 0, sizeof(backend->latency));
+	}
+	
+	backend->latency_tracking = RTEST(value);
+}
+
+void IO_Event_Selector_latency_record(struct IO_Event_Selector *backend, const struct timespec *time) {
+	struct timespec now, delay;
+	IO_Event_Time_current(&now);
+	IO_Event_Time_elapsed(time, &now, &delay);
+	
+	uint64_t nanoseconds = (uint64_t)delay.tv_sec * 1000000000 + delay.tv_nsec;
+	
+	// The bucket is the number of bits required to represent the delay:
+	int bucket = nanoseconds ? 64 - __builtin_clzll(nanoseconds) : 0;
+	if (bucket >= IO_EVENT_SELECTOR_LATENCY_BUCKETS) bucket = IO_EVENT_SELECTOR_LATENCY_BUCKETS - 1;
+	
+	backend->latency[bucket] += 1;
+}
+
+VALUE IO_Event_Selector_latency_histogram(struct IO_Event_Selector *backend) {
+	if (!backend->latency_tracking) return Qnil;
+	
+	VALUE histogram = rb_ary_new_capa(IO_EVENT_SELECTOR_LATENCY_BUCKETS);
+	
+	for (int i = 0; i < IO_EVENT_SELECTOR_LATENCY_BUCKETS; i += 1) {
+		rb_ary_push(histogram, SIZET2NUM(backend->latency[i]));
+	}
+	
+	return histogram;
+}
+
+VALUE IO_Event_Selector_spin(struct IO_Event_Selector *backend) {
+	return DBL2NUM(backend->spin.tv_sec + (backend->spin.tv_nsec / 1000000000.0));
+}
+
+void IO_Event_Selector_spin_set(struct IO_Event_Selector *backend, VALUE value) {
+	double duration = NIL_P(value) ? 0 : NUM2DBL(value);
+	
+	if (duration < 0) {
+		rb_raise(rb_eArgError, "spin must be at least 0!");
+	}
+	
+	backend->spin.tv_sec = duration;
+	backend->spin.tv_nsec = (duration - backend->spin.tv_sec) * 1000000000.0;
+}
+
+static inline
+int IO_Event_Selector_timespec_less(const struct timespec *a, const struct timespec *b) {
+	return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+int IO_Event_Selector_spin_wait(struct IO_Event_Selector *backend, struct timespec *timeout, int (*poll)(void *data), void *data) {
+	if (backend->spin.tv_sec == 0 && backend->spin.tv_nsec == 0) {
+		return 0;
+	}
+	
+	// Don't spin for longer than the requested timeout:
+	struct timespec budget = backend->spin;
+	if (timeout && IO_Event_Selector_timespec_less(timeout, &budget)) {
+		budget = *timeout;
+	}
+	
+	backend->statistics.spins += 1;
+	
+	struct timespec start_time, current_time, elapsed;
+	IO_Event_Time_current(&start_time);
+	
+	int result = 0;
+	
+	while (1) {
+		result = poll(data);
+		
+		IO_Event_Time_current(&current_time);
+		IO_Event_Time_elapsed(&start_time, &current_time, &elapsed);
+		
+		if (result) {
+			backend->statistics.spin_hits += 1;
+			break;
+		}
+		
+		if (!IO_Event_Selector_timespec_less(&elapsed, &budget)) {
+			break;
+		}
+	}
+	
+	if (timeout) {
+		// A successful poll can finish after the timeout, so clamp the elapsed time to avoid underflowing:
+		if (IO_Event_Selector_timespec_less(timeout, &elapsed)) elapsed = *timeout;
+		
+		timeout->tv_sec -= elapsed.tv_sec;
+		timeout->tv_nsec -= elapsed.tv_nsec;
+		
+		if (timeout->tv_nsec < 0) {
+			timeout->tv_sec -= 1;
+			timeout->tv_nsec += 1000000000;
+		}
+	}
+	
+	return result;
 }
 
 VALUE IO_Event_Selector_loop_resume(struct IO_Event_Selector *backend, VALUE fiber, int argc, VALUE *argv) {
@@ -240,6 +378,10 @@ static void queue_push(struct IO_Event_Selector *backend, struct IO_Event_Select
 	
 	// We always push to the front/head:
 	backend->waiting = waiting;
+	
+	if (backend->latency_tracking) {
+		IO_Event_Time_current(&waiting->time);
+	}
 }
 
 static VALUE wait_and_transfer(VALUE _arguments) {
@@ -320,20 +462,132 @@ VALUE IO_Event_Selector_raise(struct IO_Event_Selector *backend, int argc, VALUE
 	return rb_ensure(wait_and_raise, (VALUE)&arguments, wait_and_transfer_ensure, (VALUE)&arguments);
 }
 
-void IO_Event_Selector_ready_push(struct IO_Event_Selector *backend, VALUE fiber)
+// Take a node from the pool, or allocate a new one if the pool is empty.
+static inline
+struct IO_Event_Selector_Queue * IO_Event_Selector_Queue_acquire(struct IO_Event_Selector *backend)
 {
+	struct IO_Event_Selector_Queue *waiting = backend->pool;
+	
+	if (waiting) {
+		backend->pool = waiting->head;
+		backend->pool_size -= 1;
+		
+		return waiting;
+	}
+	
 	// Ruby's allocator triggers GC on memory pressure and raises `NoMemoryError` on failure, so no NULL check is required.
-	struct IO_Event_Selector_Queue *waiting = xmalloc(sizeof(struct IO_Event_Selector_Queue));
+	return xmalloc(sizeof(struct IO_Event_Selector_Queue));
+}
+
+// Return a node to the pool, or free it if the pool is full.
+static inline
+void IO_Event_Selector_Queue_release(struct IO_Event_Selector *backend, struct IO_Event_Selector_Queue *waiting)
+{
+	if (backend->pool_size < IO_EVENT_SELECTOR_QUEUE_POOL_LIMIT) {
+		waiting->head = backend->pool;
+		waiting->tail = NULL;
+		waiting->fiber = Qnil;
+		
+		backend->pool = waiting;
+		backend->pool_size += 1;
+	} else {
+		xfree(waiting);
+	}
+}
+
+void IO_Event_Selector_ready_push(struct IO_Event_Selector *backend, VALUE fiber)
+{
+	struct IO_Event_Selector_Queue *waiting = IO_Event_Selector_Queue_acquire(backend);
 	
 	waiting->head = NULL;
 	waiting->tail = NULL;
 	waiting->flags = IO_EVENT_SELECTOR_QUEUE_INTERNAL;
+	waiting->time = (struct timespec){0};
 	
 	RB_OBJ_WRITE(backend->self, &waiting->fiber, fiber);
 	
 	queue_push(backend, waiting);
 }
 
+int IO_Event_Selector_remote_push(struct IO_Event_Selector *backend, VALUE fiber)
+{
+	// The pool belongs to the event loop's thread, so remote nodes are allocated separately (but are returned to the pool once they are resumed):
+	struct IO_Event_Selector_Queue *waiting = xmalloc(sizeof(struct IO_Event_Selector_Queue));
+	
+	waiting->tail = NULL;
+	waiting->flags = IO_EVENT_SELECTOR_QUEUE_INTERNAL;
+	waiting->time = (struct timespec){0};
+	waiting->fiber = fiber;
+	
+	if (backend->latency_tracking) {
+		IO_Event_Time_current(&waiting->time);
+	}
+	
+	RB_OBJ_WRITTEN(backend->self, Qundef, fiber);
+	
+	struct IO_Event_Selector_Queue *remote = __atomic_load_n(&backend->remote, __ATOMIC_RELAXED);
+	
+	do {
+		waiting->head = remote;
+	} while (!__atomic_compare_exchange_n(&backend->remote, &remote, waiting, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+	
+	// Fibers pushed onto a non-empty stack are covered by the push which made it non-empty, since the stack is only emptied by the event loop, which then checks it again before blocking:
+	if (remote) return 0;
+	
+	// This pairs with `IO_Event_Selector_blocking_operation`, which sets `blocked` before checking for remote fibers, so either it sees our fiber, or we see that it is blocked:
+	return __atomic_load_n(&backend->blocked, __ATOMIC_SEQ_CST);
+}
+
+// Move fibers pushed from other threads into the ready queue, in the order they were pushed.
+static
+void IO_Event_Selector_remote_drain(struct IO_Event_Selector *backend)
+{
+	if (!__atomic_load_n(&backend->remote, __ATOMIC_RELAXED)) return;
+	
+	struct IO_Event_Selector_Queue *remote = __atomic_exchange_n(&backend->remote, NULL, __ATOMIC_ACQUIRE);
+	
+	// The stack is in reverse order:
+	struct IO_Event_Selector_Queue *ordered = NULL;
+	while (remote) {
+		struct IO_Event_Selector_Queue *head = remote->head;
+		remote->head = ordered;
+		ordered = remote;
+		remote = head;
+	}
+	
+	while (ordered) {
+		struct IO_Event_Selector_Queue *head = ordered->head;
+		struct timespec time = ordered->time;
+		
+		ordered->head = NULL;
+		queue_push(backend, ordered);
+		
+		// Latency is measured from when the fiber was pushed, not when it was drained:
+		ordered->time = time;
+		
+		ordered = head;
+	}
+}
+
+static
+void IO_Event_Selector_Queue_free(struct IO_Event_Selector_Queue *waiting)
+{
+	while (waiting) {
+		struct IO_Event_Selector_Queue *head = waiting->head;
+		xfree(waiting);
+		waiting = head;
+	}
+}
+
+void IO_Event_Selector_free(struct IO_Event_Selector *backend)
+{
+	IO_Event_Selector_Queue_free(__atomic_exchange_n(&backend->remote, NULL, __ATOMIC_ACQUIRE));
+	
+	IO_Event_Selector_Queue_free(backend->pool);
+	backend->pool = NULL;
+	backend->pool_size = 0;
+}
+
 static inline
 void IO_Event_Selector_ready_pop(struct IO_Event_Selector *backend, struct IO_Event_Selector_Queue *ready)
 {
@@ -341,10 +595,15 @@ void IO_Event_Selector_ready_pop(struct IO_Event_Selector *backend, struct IO_Ev
 	
 	VALUE fiber = ready->fiber;
 	
+	// Items queued before tracking was enabled have no time:
+	if (backend->latency_tracking && (ready->time.tv_sec || ready->time.tv_nsec)) {
+		IO_Event_Selector_latency_record(backend, &ready->time);
+	}
+	
 	if (ready->flags & IO_EVENT_SELECTOR_QUEUE_INTERNAL) {
 		// This means that the fiber was added to the ready queue by the selector itself, and we need to transfer control to it, but before we do that, we need to remove it from the queue, as there is no expectation that returning from `transfer` will remove it.
 		queue_pop(backend, ready);
-		xfree(ready);
+		IO_Event_Selector_Queue_release(backend, ready);
 	} else if (ready->flags & IO_EVENT_SELECTOR_QUEUE_FIBER) {
 		// This means the fiber added itself to the ready queue, and we need to transfer control back to it. Transferring control back to the fiber will call `queue_pop` and remove it from the queue.
 	} else {
@@ -358,6 +617,8 @@ int IO_Event_Selector_ready_flush(struct IO_Event_Selector *backend)
 {
 	int count = 0;
 	
+	IO_Event_Selector_remote_drain(backend);
+	
 	// During iteration of the queue, the same item may be re-queued. If we don't handle this correctly, we may end up in an infinite loop. So, to avoid this situation, we keep note of the current head of the queue and break the loop if we reach the same item again.
 	
 	// Get the current tail and head of the queue:
@@ -376,5 +637,10 @@ int IO_Event_Selector_ready_flush(struct IO_Event_Selector *backend)
 		if (ready == waiting) break;
 	}
 	
+	if (count) {
+		backend->statistics.ready_flushes += 1;
+		backend->statistics.ready_resumes += count;
+	}
+	
 	return count;
 }
@@ -82,6 +82,42 @@ struct IO_Event_Selector_Queue {
 	enum IO_Event_Selector_Queue_Flags flags;
 	
 	VALUE fiber;
+	
+	// The time at which the fiber was queued, only set if latency tracking is enabled:
+	struct timespec time;
+};
+
+enum {
+	// The maximum number of unused ready queue nodes kept for reuse by each selector:
+	IO_EVENT_SELECTOR_QUEUE_POOL_LIMIT = 1024,
+	
+	// The number of buckets in the scheduling latency histogram. Bucket `i` counts delays of at least `2^(i-1)` and less than `2^i` nanoseconds, and the last bucket counts all longer delays (more than ~275 seconds):
+	IO_EVENT_SELECTOR_LATENCY_BUCKETS = 40,
+};
+
+// Runtime counters, which are plain integers so that they are cheap enough to update unconditionally.
+struct IO_Event_Selector_Statistics {
+	// The number of calls to `select`, and how many of those entered a blocking wait:
+	size_t selects;
+	size_t blocking_waits;
+	
+	// The number of events (or completions) processed by `select`:
+	size_t events;
+	
+	// The number of times the ready queue was flushed while it contained fibers, and the number of fibers it resumed:
+	size_t ready_flushes;
+	size_t ready_resumes;
+	
+	// The number of calls to `wakeup`, and how many of those had to interrupt a blocked selector:
+	size_t wakeups;
+	size_t wakeup_signals;
+	
+	// The number of operations which were cancelled before they completed (e.g. by an exception or timeout):
+	size_t cancellations;
+	
+	// The number of times the selector spun before blocking, and how many of those found events:
+	size_t spins;
+	size_t spin_hits;
 };
 
 // The internal state of the event selector.
@@ -99,10 +135,47 @@ struct IO_Event_Selector {
 	struct IO_Event_Selector_Queue *waiting;
 	// Process from ready (back/tail of queue).
 	struct IO_Event_Selector_Queue *ready;
+	
+	// A lock-free stack of fibers pushed from other threads, linked through `head`, which is moved into the ready queue by `IO_Event_Selector_ready_flush`.
+	struct IO_Event_Selector_Queue *remote;
+	
+	// Unused ready queue nodes, linked through `head`, so that pushing a fiber doesn't need to allocate:
+	struct IO_Event_Selector_Queue *pool;
+	size_t pool_size;
+	
+	// How long to keep polling for events before entering a blocking wait, or zero to block immediately:
+	struct timespec spin;
+	
+	struct IO_Event_Selector_Statistics statistics;
+	
+	// Whether to record how long fibers wait between becoming ready and being resumed:
+	int latency_tracking;
+	size_t latency[IO_EVENT_SELECTOR_LATENCY_BUCKETS];
 };
 
 void IO_Event_Selector_initialize(struct IO_Event_Selector *backend, VALUE self, VALUE loop);
 
+// Add the common runtime statistics to the given hash, and return it.
+VALUE IO_Event_Selector_statistics(struct IO_Event_Selector *backend, VALUE statistics);
+
+// Enable or disable latency tracking. Enabling it clears the histogram.
+void IO_Event_Selector_latency_tracking_set(struct IO_Event_Selector *backend, VALUE value);
+
+// Record the delay between the given time and now in the latency histogram.
+void IO_Event_Selector_latency_record(struct IO_Event_Selector *backend, const struct timespec *time);
+
+// Get the latency histogram as an array of counts, or `nil` if latency tracking is disabled.
+VALUE IO_Event_Selector_latency_histogram(struct IO_Event_Selector *backend);
+
+// Get the spin budget in seconds.
+VALUE IO_Event_Selector_spin(struct IO_Event_Selector *backend);
+
+// Set the spin budget in seconds, where `nil` or `0` disables spinning.
+void IO_Event_Selector_spin_set(struct IO_Event_Selector *backend, VALUE value);
+
+// Repeatedly invoke the non-blocking `poll` function for up to the spin budget, until it returns a non-zero result. The elapsed time is subtracted from `timeout` (which may be `NULL` for no timeout), so that the subsequent blocking wait doesn't exceed the requested duration.
+int IO_Event_Selector_spin_wait(struct IO_Event_Selector *backend, struct timespec *timeout, int (*poll)(void *data), void *data);
+
 static inline
 void IO_Event_Selector_mark(struct IO_Event_Selector *backend) {
 	rb_gc_mark_movable(backend->self);
@@ -114,6 +187,13 @@ void IO_Event_Selector_mark(struct IO_Event_Selector *backend) {
 		rb_gc_mark_movable(ready->fiber);
 		ready = ready->head;
 	}
+	
+	// Remote fibers are pushed while holding the GVL, so the stack can't change while marking:
+	struct IO_Event_Selector_Queue *remote = backend->remote;
+	while (remote) {
+		rb_gc_mark_movable(remote->fiber);
+		remote = remote->head;
+	}
 }
 
 static inline
@@ -126,6 +206,12 @@ void IO_Event_Selector_compact(struct IO_Event_Selector *backend) {
 		ready->fiber = rb_gc_location(ready->fiber);
 		ready = ready->head;
 	}
+	
+	struct IO_Event_Selector_Queue *remote = backend->remote;
+	while (remote) {
+		remote->fiber = rb_gc_location(remote->fiber);
+		remote = remote->head;
+	}
 }
 
 // Transfer control from the event loop to a user fiber.
@@ -172,5 +258,19 @@ VALUE IO_Event_Selector_yield(struct IO_Event_Selector *backend)
 // The implementation will transfer control to the fiber later on.
 void IO_Event_Selector_ready_push(struct IO_Event_Selector *backend, VALUE fiber);
 
+// Append a specific fiber to the ready queue from any thread. The fiber is pushed onto a lock-free stack, which is moved into the ready queue the next time it is flushed.
+// Returns whether the caller must wake up the selector, which is only the case for the first fiber pushed while it is blocked. If the selector is about to block, it will notice the fiber and not block.
+int IO_Event_Selector_remote_push(struct IO_Event_Selector *backend, VALUE fiber);
+
+// Release the memory held by the selector state, including fibers which were pushed from another thread but never moved into the ready queue, and unused ready queue nodes.
+void IO_Event_Selector_free(struct IO_Event_Selector *backend);
+
+// Whether there are fibers in the ready queue, or pushed from another thread, which are waiting to be resumed.
+static inline
+int IO_Event_Selector_ready_p(struct IO_Event_Selector *backend)
+{
+	return backend->ready || __atomic_load_n(&backend->remote, __ATOMIC_RELAXED);
+}
+
 // Flush the ready queue by transferring control one at a time.
 int IO_Event_Selector_ready_flush(struct IO_Event_Selector *backend);
@@ -8,6 +8,11 @@
 
 #include <liburing.h>
 #include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
@@ -15,8 +20,16 @@
 
 #include "../interrupt.h"
 
+#ifdef HAVE_RUBY_IO_BUFFER_H
+#include "iovec.h"
+#endif
+
 #include <linux/version.h>
 
+#if defined(HAVE_PREADV2) && defined(HAVE_PWRITEV2) && defined(RWF_NOWAIT)
+#define IO_EVENT_SELECTOR_URING_RWF_NOWAIT
+#endif
+
 // `io_uring` support for `IORING_OP_WAITID` was introduced in Linux 6.7. When available, we use it to wait for process exit directly in the ring, instead of polling on a pidfd.
 #if defined(HAVE_IO_URING_PREP_WAITID) && (LINUX_VERSION_CODE >= KERNEL_VERSION(6,7,0))
 #define IO_EVENT_SELECTOR_URING_USE_WAITID
@@ -32,7 +45,72 @@ enum {
 	DEBUG_CQE = 0,
 };
 
-enum {URING_ENTRIES = 64};
+enum {
+	// The default size of the submission queue:
+	URING_ENTRIES = 64,
+	
+	// The default size of the completion queue, relative to the submission queue. Multishot operations can post many completions for a single submission, so this is larger than the kernel's default of 2:
+	URING_COMPLETION_FACTOR = 4,
+	
+	// The maximum number of bytes spliced through the intermediate pipe at once, which matches the default pipe capacity so the pipe never fills up:
+	URING_SPLICE_CHUNK = 1024 * 64,
+	
+	// After this many consecutive optimistic attempts would have blocked, further attempts are skipped:
+	URING_OPTIMISTIC_MISSES = 4,
+	
+	// Skipped attempts back off exponentially, up to `1 << URING_OPTIMISTIC_BACKOFF` operations, after which another attempt is made:
+	URING_OPTIMISTIC_BACKOFF = 6,
+};
+
+static ID id_entries, id_completion_entries, id_sqpoll, id_sq_thread_cpu, id_sq_thread_idle;
+
+// Provided buffer rings (`IORING_REGISTER_PBUF_RING`) were introduced in Linux 5.19, and `io_uring_setup_buf_ring` in liburing 2.4.
+#ifdef HAVE_IO_URING_SETUP_BUF_RING
+#define IO_EVENT_SELECTOR_URING_BUFFER_RING
+
+enum {
+	// The buffer group identifier used for the selector's provided buffers:
+	URING_BUFFER_GROUP = 0,
+	
+	// The maximum number of entries in a provided buffer ring:
+	URING_BUFFER_COUNT_MAXIMUM = 32768,
+};
+#endif
+
+// Multishot accept (`IORING_ACCEPT_MULTISHOT`) was introduced in Linux 5.19, and `io_uring_prep_multishot_accept` in liburing 2.2.
+#ifdef HAVE_IO_URING_PREP_MULTISHOT_ACCEPT
+#define IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+
+enum {
+	// Completions for multishot accepts carry a pointer to the acceptor, tagged with this bit to distinguish them from regular completions:
+	URING_USER_DATA_ACCEPTOR = 1,
+};
+#endif
+
+// Multishot poll (`IORING_POLL_ADD_MULTI`) was introduced in Linux 5.13, and `io_uring_prep_poll_multishot` in liburing 2.2.
+#ifdef HAVE_IO_URING_PREP_POLL_MULTISHOT
+#define IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+
+enum {
+	// Completions for multishot polls carry a pointer to the poller, tagged with this bit to distinguish them from regular completions:
+	URING_USER_DATA_POLLER = 2,
+};
+#endif
+
+// Zero-copy sends (`IORING_OP_SEND_ZC`) were introduced in Linux 6.0, and `io_uring_prep_send_zc` in liburing 2.3.
+#ifdef HAVE_IO_URING_PREP_SEND_ZC
+#define IO_EVENT_SELECTOR_URING_SEND_ZC
+#endif
+
+// Sparse fixed file tables (`IORING_RSRC_REGISTER_SPARSE`) were introduced in Linux 5.19, and `io_uring_register_files_sparse` in liburing 2.2.
+#ifdef HAVE_IO_URING_REGISTER_FILES_SPARSE
+#define IO_EVENT_SELECTOR_URING_FIXED_FILES
+
+enum {
+	// The maximum size of the fixed file table. Descriptors beyond this (or beyond `RLIMIT_NOFILE`) can't be registered and use regular descriptors:
+	URING_FILES_MAXIMUM = 65536,
+};
+#endif
 
 #pragma mark - Data Type
 
@@ -57,8 +135,82 @@ struct IO_Event_Selector_URing
 	
 	struct timespec idle_duration;
 	
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+	// Writes of at least this many bytes use zero-copy sends, or 0 if disabled:
+	size_t zero_copy_threshold;
+#endif
+	
+	// The number of times `io_get_sqe` found the submission queue full and had to submit early:
+	size_t submission_queue_full;
+	
+	// The number of times the kernel reported completions which didn't fit in the completion queue:
+	size_t completion_queue_overflow;
+	
+	// The number of `io_uring_submit` calls which submitted entries, and the total number of entries they submitted:
+	size_t submissions;
+	size_t submitted_entries;
+	
+	// The number of submissions which had to wake up the sleeping SQPOLL kernel thread:
+	size_t sqpoll_wakeups;
+	
+	// Whether `io_read` and `io_write` first try the operation directly on sockets and pipes, and only submit it to the ring if it would block:
+	int optimistic_io;
+	
+	// The number of optimistic attempts which completed, and which would have blocked:
+	size_t optimistic_hits;
+	size_t optimistic_misses;
+	
+	// Per-descriptor state for optimistic operations, indexed by descriptor:
+	struct IO_Event_Array descriptors;
+	
+	// The intermediate pipe used by `io_splice`, created on first use, or -1. It is empty between operations, and discarded if an operation leaves data in it:
+	int splice_pipe[2];
+	
+	// Whether a fiber is currently using the splice pipe, in which case other fibers use a temporary pipe:
+	int splice_busy;
+	
 	struct IO_Event_Array completions;
 	struct IO_Event_List free_list;
+	
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+	// A ring of provided buffers, used by `io_read_provided`. The kernel selects a buffer only when data arrives, so pending reads don't pin any memory.
+	struct {
+		struct io_uring_buf_ring *ring;
+		
+		// Contiguous storage for all buffers, `count * size` bytes:
+		char *base;
+		
+		unsigned count;
+		unsigned size;
+	} buffers;
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	// Multishot accept state, indexed by server descriptor:
+	struct IO_Event_Array acceptors;
+	
+	// Acceptors which were detached from their descriptor while the multishot accept was armed, until its final completion arrives:
+	struct IO_Event_List orphaned_acceptors;
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	// Whether `io_wait` registers persistent multishot polls rather than submitting a one-shot poll for every wait:
+	int multishot_poll;
+	
+	// Multishot poll state, indexed by descriptor:
+	struct IO_Event_Array pollers;
+	
+	// Pollers which were detached from their descriptor while the multishot poll was armed, until its final completion arrives:
+	struct IO_Event_List orphaned_pollers;
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	// Registered files, indexed by descriptor. Each descriptor occupies the slot of the same index in the fixed file table, so operations only need to set `IOSQE_FIXED_FILE`:
+	struct IO_Event_Array files;
+	
+	// The size of the fixed file table, or 0 if it has not been allocated yet:
+	unsigned files_limit;
+#endif
 };
 
 struct IO_Event_Selector_URing_Completion;
@@ -93,11 +245,224 @@ void IO_Event_Selector_URing_Completion_mark(void *_completion)
 	}
 }
 
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+// A fiber waiting in `io_accept`, allocated on the fiber's stack.
+struct IO_Event_Selector_URing_Acceptor_Waiting
+{
+	struct IO_Event_List list;
+	
+	VALUE fiber;
+	
+	// The accepted descriptor, or a negative errno:
+	int result;
+	
+	// Whether the result has been set:
+	int ready;
+};
+
+struct IO_Event_Selector_URing_Acceptor
+{
+	// The node in the selector's list of orphaned acceptors:
+	struct IO_Event_List list;
+	
+	// The server IO which the acceptor was used with. A different IO means the descriptor was closed without `io_close` and reused:
+	VALUE io;
+	
+	// Whether a multishot accept is currently armed for this descriptor:
+	int armed;
+	
+	// Whether the server was closed while the multishot accept was armed. The acceptor is then owned by the in-flight accept and freed by its final completion, or when the selector is closed:
+	int orphaned;
+	
+	// An error which terminated the multishot accept while no fiber was waiting, as a negative errno:
+	int error;
+	
+	// Fibers waiting to accept a connection, oldest first:
+	struct IO_Event_List waiting;
+	
+	// Descriptors accepted while no fiber was waiting, as a circular buffer:
+	int *accepted;
+	size_t head, count, capacity;
+};
+
+static
+void IO_Event_Selector_URing_Acceptor_mark(void *_acceptor)
+{
+	struct IO_Event_Selector_URing_Acceptor *acceptor = _acceptor;
+	
+	if (acceptor->io) {
+		rb_gc_mark_movable(acceptor->io);
+	}
+	
+	for (struct IO_Event_List *node = acceptor->waiting.tail; node != &acceptor->waiting; node = node->tail) {
+		struct IO_Event_Selector_URing_Acceptor_Waiting *waiting = (struct IO_Event_Selector_URing_Acceptor_Waiting *)node;
+		rb_gc_mark_movable(waiting->fiber);
+	}
+}
+
+static
+void IO_Event_Selector_URing_Acceptor_compact(void *_acceptor)
+{
+	struct IO_Event_Selector_URing_Acceptor *acceptor = _acceptor;
+	
+	if (acceptor->io) {
+		acceptor->io = rb_gc_location(acceptor->io);
+	}
+	
+	for (struct IO_Event_List *node = acceptor->waiting.tail; node != &acceptor->waiting; node = node->tail) {
+		struct IO_Event_Selector_URing_Acceptor_Waiting *waiting = (struct IO_Event_Selector_URing_Acceptor_Waiting *)node;
+		waiting->fiber = rb_gc_location(waiting->fiber);
+	}
+}
+#endif
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+// A fiber waiting in `io_wait` on a multishot poll, allocated on the fiber's stack.
+struct IO_Event_Selector_URing_Poller_Waiting
+{
+	struct IO_Event_List list;
+	
+	VALUE fiber;
+	
+	// The poll flags we are waiting for:
+	short flags;
+	
+	// The poll flags which occurred, or a negative errno:
+	int result;
+	
+	// Whether the result has been set:
+	int ready;
+};
+
+// This represents zero or more fibers waiting for a specific descriptor, sharing a single multishot poll.
+struct IO_Event_Selector_URing_Poller
+{
+	// The node in the selector's list of orphaned pollers:
+	struct IO_Event_List list;
+	
+	// Fibers waiting for events, oldest first:
+	struct IO_Event_List waiting;
+	
+	// The IO object which was used to register the poll.
+	VALUE io;
+	
+	// The descriptor the poll is registered for, used to arm it again if the kernel terminates it:
+	int descriptor;
+	
+	// The poll flags of the armed multishot poll, or 0 if it is not armed:
+	short registered;
+	
+	// Poll flags which were reported while no fiber was waiting for them:
+	short ready;
+	
+	// Whether the poller was replaced or its descriptor closed while the multishot poll was armed. The poller is then owned by the in-flight poll and freed by its final completion, or when the selector is closed:
+	int orphaned;
+};
+
+static
+void IO_Event_Selector_URing_Poller_mark(void *_poller)
+{
+	struct IO_Event_Selector_URing_Poller *poller = _poller;
+	
+	for (struct IO_Event_List *node = poller->waiting.tail; node != &poller->waiting; node = node->tail) {
+		struct IO_Event_Selector_URing_Poller_Waiting *waiting = (struct IO_Event_Selector_URing_Poller_Waiting *)node;
+		rb_gc_mark_movable(waiting->fiber);
+	}
+	
+	if (poller->io) {
+		rb_gc_mark_movable(poller->io);
+	}
+}
+
+static
+void IO_Event_Selector_URing_Poller_compact(void *_poller)
+{
+	struct IO_Event_Selector_URing_Poller *poller = _poller;
+	
+	for (struct IO_Event_List *node = poller->waiting.tail; node != &poller->waiting; node = node->tail) {
+		struct IO_Event_Selector_URing_Poller_Waiting *waiting = (struct IO_Event_Selector_URing_Poller_Waiting *)node;
+		waiting->fiber = rb_gc_location(waiting->fiber);
+	}
+	
+	if (poller->io) {
+		poller->io = rb_gc_location(poller->io);
+	}
+}
+#endif
+
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+struct IO_Event_Selector_URing_File
+{
+	// The IO object which was registered, or 0 if the slot is empty:
+	VALUE io;
+};
+
+static
+void IO_Event_Selector_URing_File_mark(void *_file)
+{
+	struct IO_Event_Selector_URing_File *file = _file;
+	
+	if (file->io) {
+		rb_gc_mark_movable(file->io);
+	}
+}
+
+static
+void IO_Event_Selector_URing_File_compact(void *_file)
+{
+	struct IO_Event_Selector_URing_File *file = _file;
+	
+	if (file->io) {
+		file->io = rb_gc_location(file->io);
+	}
+}
+#endif
+
+enum IO_Event_Selector_URing_Descriptor_Kind {
+	// The descriptor has not been inspected yet:
+	IO_EVENT_SELECTOR_URING_DESCRIPTOR_UNKNOWN = 0,
+	IO_EVENT_SELECTOR_URING_DESCRIPTOR_SOCKET,
+	IO_EVENT_SELECTOR_URING_DESCRIPTOR_PIPE,
+	
+	// Optimistic operations are not supported, e.g. for regular files which are better served by the ring:
+	IO_EVENT_SELECTOR_URING_DESCRIPTOR_OTHER,
+};
+
+// Tracks whether optimistic operations in one direction are worthwhile.
+struct IO_Event_Selector_URing_Attempts
+{
+	// The number of consecutive attempts which would have blocked:
+	unsigned misses;
+	
+	// The number of operations which will be submitted directly to the ring before trying again:
+	unsigned skip;
+};
+
+struct IO_Event_Selector_URing_Descriptor
+{
+	enum IO_Event_Selector_URing_Descriptor_Kind kind;
+	
+	// Reads and writes are tracked separately, e.g. writes to an idle connection usually succeed while reads would block:
+	struct IO_Event_Selector_URing_Attempts read, write;
+};
+
 void IO_Event_Selector_URing_Type_mark(void *_selector)
 {
 	struct IO_Event_Selector_URing *selector = _selector;
 	IO_Event_Selector_mark(&selector->backend);
 	IO_Event_Array_each(&selector->completions, IO_Event_Selector_URing_Completion_mark);
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	IO_Event_Array_each(&selector->acceptors, IO_Event_Selector_URing_Acceptor_mark);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	IO_Event_Array_each(&selector->pollers, IO_Event_Selector_URing_Poller_mark);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	IO_Event_Array_each(&selector->files, IO_Event_Selector_URing_File_mark);
+#endif
 }
 
 static
@@ -115,12 +480,49 @@ void IO_Event_Selector_URing_Type_compact(void *_selector)
 	struct IO_Event_Selector_URing *selector = _selector;
 	IO_Event_Selector_compact(&selector->backend);
 	IO_Event_Array_each(&selector->completions, IO_Event_Selector_URing_Completion_compact);
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	IO_Event_Array_each(&selector->acceptors, IO_Event_Selector_URing_Acceptor_compact);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	IO_Event_Array_each(&selector->pollers, IO_Event_Selector_URing_Poller_compact);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	IO_Event_Array_each(&selector->files, IO_Event_Selector_URing_File_compact);
+#endif
+}
+
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+// Return a selected buffer to the ring so that the kernel can use it again.
+static inline
+void IO_Event_Selector_URing_buffers_recycle(struct IO_Event_Selector_URing *selector, unsigned short index)
+{
+	io_uring_buf_ring_add(selector->buffers.ring, selector->buffers.base + (size_t)index * selector->buffers.size, selector->buffers.size, index, io_uring_buf_ring_mask(selector->buffers.count), 0);
+	io_uring_buf_ring_advance(selector->buffers.ring, 1);
 }
+#endif
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+static void IO_Event_Selector_URing_Acceptors_close(struct IO_Event_Selector_URing *selector);
+#endif
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+static void IO_Event_Selector_URing_Pollers_close(struct IO_Event_Selector_URing *selector);
+#endif
 
 static
 void close_internal(struct IO_Event_Selector_URing *selector)
 {
 	if (selector->owner == getpid()) {
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+		if (selector->buffers.ring) {
+			io_uring_free_buf_ring(&selector->ring, selector->buffers.ring, selector->buffers.count, URING_BUFFER_GROUP);
+			selector->buffers.ring = NULL;
+		}
+#endif
+		
 		if (selector->interrupt.descriptor >= 0) {
 			IO_Event_Interrupt_close(&selector->interrupt);
 			selector->interrupt.descriptor = -1;
@@ -135,7 +537,30 @@ void close_internal(struct IO_Event_Selector_URing *selector)
 		selector->interrupt.descriptor = -1;
 		selector->wakeup_registered = 0;
 		selector->ring.ring_fd = -1;
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+		selector->buffers.ring = NULL;
+#endif
+	}
+	
+	if (selector->splice_pipe[0] >= 0) {
+		close(selector->splice_pipe[0]);
+		close(selector->splice_pipe[1]);
+		selector->splice_pipe[0] = selector->splice_pipe[1] = -1;
 	}
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	IO_Event_Selector_URing_Acceptors_close(selector);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	IO_Event_Selector_URing_Pollers_close(selector);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	// The fixed file table is released with the ring:
+	selector->files_limit = 0;
+	IO_Event_Array_truncate(&selector->files, 0);
+#endif
 }
 
 static
@@ -145,7 +570,28 @@ void IO_Event_Selector_URing_Type_free(void *_selector)
 	
 	close_internal(selector);
 	
+	IO_Event_Selector_free(&selector->backend);
 	IO_Event_Array_free(&selector->completions);
+	IO_Event_Array_free(&selector->descriptors);
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	IO_Event_Array_free(&selector->acceptors);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	IO_Event_Array_free(&selector->pollers);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	IO_Event_Array_free(&selector->files);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+	if (selector->buffers.base) {
+		xfree(selector->buffers.base);
+		selector->buffers.base = NULL;
+	}
+#endif
 	
 	xfree(selector);
 }
@@ -155,10 +601,29 @@ size_t IO_Event_Selector_URing_Type_size(const void *_selector)
 {
 	const struct IO_Event_Selector_URing *selector = _selector;
 	
-	return sizeof(struct IO_Event_Selector_URing)
+	size_t size = sizeof(struct IO_Event_Selector_URing)
 		+ IO_Event_Array_memory_size(&selector->completions)
+		+ IO_Event_Array_memory_size(&selector->descriptors)
 		+ IO_Event_List_memory_size(&selector->free_list)
 	;
+	
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+	size += (size_t)selector->buffers.count * selector->buffers.size;
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	size += IO_Event_Array_memory_size(&selector->acceptors);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	size += IO_Event_Array_memory_size(&selector->pollers);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	size += IO_Event_Array_memory_size(&selector->files);
+#endif
+	
+	return size;
 }
 
 static const rb_data_type_t IO_Event_Selector_URing_Type = {
@@ -242,42 +707,309 @@ void IO_Event_Selector_URing_Completion_free(void *element)
 	IO_Event_Selector_URing_Completion_cancel(completion);
 }
 
-VALUE IO_Event_Selector_URing_allocate(VALUE self) {
-	struct IO_Event_Selector_URing *selector = NULL;
-	VALUE instance = TypedData_Make_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+void IO_Event_Selector_URing_Acceptor_initialize(void *element)
+{
+	struct IO_Event_Selector_URing_Acceptor *acceptor = element;
 	
-	IO_Event_Selector_initialize(&selector->backend, self, Qnil);
-	selector->ring.ring_fd = -1;
-	selector->owner = 0;
+	IO_Event_List_initialize(&acceptor->list);
+	acceptor->io = 0;
+	acceptor->armed = 0;
+	acceptor->orphaned = 0;
+	acceptor->error = 0;
+	IO_Event_List_initialize(&acceptor->waiting);
 	
-	selector->interrupt.descriptor = -1;
-	selector->wakeup_registered = 0;
+	acceptor->accepted = NULL;
+	acceptor->head = acceptor->count = acceptor->capacity = 0;
+}
+
+// Close any accepted descriptors which were never handed to a fiber, and reset the error state.
+static
+void IO_Event_Selector_URing_Acceptor_reset(struct IO_Event_Selector_URing_Acceptor *acceptor)
+{
+	for (size_t i = 0; i < acceptor->count; i += 1) {
+		close(acceptor->accepted[(acceptor->head + i) % acceptor->capacity]);
+	}
 	
-	IO_Event_List_initialize(&selector->free_list);
+	acceptor->head = acceptor->count = 0;
+	acceptor->error = 0;
+}
+
+void IO_Event_Selector_URing_Acceptor_free(void *element)
+{
+	struct IO_Event_Selector_URing_Acceptor *acceptor = element;
 	
-	selector->completions.element_initialize = IO_Event_Selector_URing_Completion_initialize;
-	selector->completions.element_free = IO_Event_Selector_URing_Completion_free;
-	IO_Event_Array_initialize(&selector->completions, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_Completion));
+	IO_Event_Selector_URing_Acceptor_reset(acceptor);
 	
-	return instance;
+	if (acceptor->accepted) {
+		xfree(acceptor->accepted);
+		acceptor->accepted = NULL;
+	}
 }
 
-#pragma mark - Methods
-
-VALUE IO_Event_Selector_URing_initialize(VALUE self, VALUE loop) {
-	struct IO_Event_Selector_URing *selector = NULL;
-	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
-	
-	IO_Event_Selector_initialize(&selector->backend, self, loop);
+// The ring has been closed, so no further completions will arrive. Orphaned acceptors are freed, and descriptors which were accepted but never handed to a fiber are closed.
+static
+void IO_Event_Selector_URing_Acceptors_close(struct IO_Event_Selector_URing *selector)
+{
+	while (!IO_Event_List_empty(&selector->orphaned_acceptors)) {
+		struct IO_Event_Selector_URing_Acceptor *acceptor = (struct IO_Event_Selector_URing_Acceptor *)selector->orphaned_acceptors.tail;
+		IO_Event_List_pop(&acceptor->list);
+		
+		IO_Event_Selector_URing_Acceptor_free(acceptor);
+		xfree(acceptor);
+	}
 	
-	unsigned int flags = 0;
-	// IORING_SETUP_SINGLE_ISSUER (kernel 6.0+): only the owner thread submits SQEs.
-	// Safe here because wakeup() uses eventfd (no ring access from other threads).
-#ifdef IORING_SETUP_SINGLE_ISSUER
-	flags |= IORING_SETUP_SINGLE_ISSUER;
+	for (size_t descriptor = 0; descriptor < selector->acceptors.limit; descriptor += 1) {
+		struct IO_Event_Selector_URing_Acceptor *acceptor = selector->acceptors.base[descriptor];
+		
+		if (acceptor) {
+			IO_Event_Selector_URing_Acceptor_reset(acceptor);
+			acceptor->armed = 0;
+		}
+	}
+}
 #endif
-	// IORING_SETUP_DEFER_TASKRUN (kernel 6.1+, requires SINGLE_ISSUER): defer io_uring
-	// task work to the application thread rather than a kernel thread, reducing
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+void IO_Event_Selector_URing_Poller_initialize(void *element)
+{
+	struct IO_Event_Selector_URing_Poller *poller = element;
+	
+	IO_Event_List_initialize(&poller->list);
+	IO_Event_List_initialize(&poller->waiting);
+	poller->io = 0;
+	poller->descriptor = -1;
+	poller->registered = 0;
+	poller->ready = 0;
+	poller->orphaned = 0;
+}
+
+void IO_Event_Selector_URing_Poller_free(void *element)
+{
+	// Waiting fibers are allocated on their own stacks, so there is nothing to release.
+}
+
+// The ring has been closed, so no further completions will arrive, and orphaned pollers are freed.
+static
+void IO_Event_Selector_URing_Pollers_close(struct IO_Event_Selector_URing *selector)
+{
+	while (!IO_Event_List_empty(&selector->orphaned_pollers)) {
+		struct IO_Event_Selector_URing_Poller *poller = (struct IO_Event_Selector_URing_Poller *)selector->orphaned_pollers.tail;
+		IO_Event_List_pop(&poller->list);
+		
+		IO_Event_Selector_URing_Poller_free(poller);
+		xfree(poller);
+	}
+	
+	for (size_t descriptor = 0; descriptor < selector->pollers.limit; descriptor += 1) {
+		struct IO_Event_Selector_URing_Poller *poller = selector->pollers.base[descriptor];
+		
+		if (poller) {
+			poller->registered = 0;
+		}
+	}
+}
+#endif
+
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+void IO_Event_Selector_URing_File_initialize(void *element)
+{
+	struct IO_Event_Selector_URing_File *file = element;
+	file->io = 0;
+}
+
+void IO_Event_Selector_URing_File_free(void *element)
+{
+	// The fixed file table itself is released with the ring.
+}
+#endif
+
+void IO_Event_Selector_URing_Descriptor_initialize(void *element)
+{
+	struct IO_Event_Selector_URing_Descriptor *descriptor = element;
+	
+	descriptor->kind = IO_EVENT_SELECTOR_URING_DESCRIPTOR_UNKNOWN;
+	descriptor->read.misses = descriptor->read.skip = 0;
+	descriptor->write.misses = descriptor->write.skip = 0;
+}
+
+void IO_Event_Selector_URing_Descriptor_free(void *element)
+{
+}
+
+VALUE IO_Event_Selector_URing_allocate(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	VALUE instance = TypedData_Make_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	IO_Event_Selector_initialize(&selector->backend, self, Qnil);
+	selector->ring.ring_fd = -1;
+	selector->owner = 0;
+	
+	selector->interrupt.descriptor = -1;
+	selector->wakeup_registered = 0;
+	
+	selector->splice_pipe[0] = selector->splice_pipe[1] = -1;
+	selector->splice_busy = 0;
+	
+	selector->submission_queue_full = 0;
+	selector->completion_queue_overflow = 0;
+	selector->submissions = 0;
+	selector->submitted_entries = 0;
+	selector->sqpoll_wakeups = 0;
+	
+	selector->optimistic_io = 0;
+	selector->optimistic_hits = 0;
+	selector->optimistic_misses = 0;
+	
+	selector->descriptors.element_initialize = IO_Event_Selector_URing_Descriptor_initialize;
+	selector->descriptors.element_free = IO_Event_Selector_URing_Descriptor_free;
+	IO_Event_Array_initialize(&selector->descriptors, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_Descriptor));
+	
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+	selector->zero_copy_threshold = 0;
+#endif
+	
+	IO_Event_List_initialize(&selector->free_list);
+	
+	selector->completions.element_initialize = IO_Event_Selector_URing_Completion_initialize;
+	selector->completions.element_free = IO_Event_Selector_URing_Completion_free;
+	IO_Event_Array_initialize(&selector->completions, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_Completion));
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	selector->acceptors.element_initialize = IO_Event_Selector_URing_Acceptor_initialize;
+	selector->acceptors.element_free = IO_Event_Selector_URing_Acceptor_free;
+	IO_Event_List_initialize(&selector->orphaned_acceptors);
+	IO_Event_Array_initialize(&selector->acceptors, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_Acceptor));
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	selector->multishot_poll = 0;
+	
+	selector->pollers.element_initialize = IO_Event_Selector_URing_Poller_initialize;
+	selector->pollers.element_free = IO_Event_Selector_URing_Poller_free;
+	IO_Event_List_initialize(&selector->orphaned_pollers);
+	IO_Event_Array_initialize(&selector->pollers, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_Poller));
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	selector->files_limit = 0;
+	
+	selector->files.element_initialize = IO_Event_Selector_URing_File_initialize;
+	selector->files.element_free = IO_Event_Selector_URing_File_free;
+	IO_Event_Array_initialize(&selector->files, IO_EVENT_ARRAY_DEFAULT_COUNT, sizeof(struct IO_Event_Selector_URing_File));
+#endif
+	
+	return instance;
+}
+
+#pragma mark - Methods
+
+static unsigned int
+initialize_entries(VALUE value, unsigned int default_value, const char *name) {
+	if (value == Qundef || NIL_P(value)) return default_value;
+	
+	int entries = NUM2INT(value);
+	if (entries <= 0) {
+		rb_raise(rb_eArgError, "%s must be greater than 0!", name);
+	}
+	
+	return (unsigned int)entries;
+}
+
+// Initialize the ring with the given parameters, retrying without `IORING_SETUP_SUBMIT_ALL` on kernels which don't support it (before Linux 5.18).
+static int
+initialize_ring(struct io_uring *ring, unsigned int entries, const struct io_uring_params *parameters) {
+	// The kernel writes back into the parameters, so use a copy for each attempt:
+	struct io_uring_params params = *parameters;
+	
+	int result = io_uring_queue_init_params(entries, ring, &params);
+	
+#ifdef IORING_SETUP_SUBMIT_ALL
+	if (result == -EINVAL && (parameters->flags & IORING_SETUP_SUBMIT_ALL)) {
+		if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_initialize: no IORING_SETUP_SUBMIT_ALL\n");
+		
+		params = *parameters;
+		params.flags &= ~IORING_SETUP_SUBMIT_ALL;
+		
+		result = io_uring_queue_init_params(entries, ring, &params);
+	}
+#endif
+	
+	return result;
+}
+
+// A kernel thread polls the submission queue, so the application thread is not involved in running task work. Deferred task running requires the opposite, and `IORING_SETUP_TASKRUN_FLAG` is only valid alongside it.
+static unsigned int
+sqpoll_flags(unsigned int flags) {
+	flags |= IORING_SETUP_SQPOLL;
+	
+#ifdef IORING_SETUP_DEFER_TASKRUN
+	flags &= ~IORING_SETUP_DEFER_TASKRUN;
+#endif
+#ifdef IORING_SETUP_TASKRUN_FLAG
+	flags &= ~IORING_SETUP_TASKRUN_FLAG;
+#endif
+	
+	return flags;
+}
+
+// `URing.new(loop, entries: 64, completion_entries: entries * 4, sqpoll: false, sq_thread_cpu: nil, sq_thread_idle: nil)`: The kernel rounds both sizes up to a power of two, and clamps them to its maximum.
+//
+// If `sqpoll` is true, a kernel thread polls the submission queue so that submitting operations doesn't require a system call. The thread can be pinned to `sq_thread_cpu`, and goes to sleep after `sq_thread_idle` seconds without work (the kernel default is one second). If the kernel refuses to create the thread (e.g. due to missing privileges or resource limits), a regular ring is used instead, which can be checked using `sqpoll?`.
+VALUE IO_Event_Selector_URing_initialize(int argc, VALUE *argv, VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	VALUE loop, kwargs = Qnil;
+	rb_scan_args(argc, argv, "1:", &loop, &kwargs);
+	
+	VALUE kwvals[5] = {Qundef, Qundef, Qundef, Qundef, Qundef};
+	if (!NIL_P(kwargs)) {
+		ID kwkeys[5] = {id_entries, id_completion_entries, id_sqpoll, id_sq_thread_cpu, id_sq_thread_idle};
+		rb_get_kwargs(kwargs, kwkeys, 0, 5, kwvals);
+	}
+	
+	unsigned int entries = initialize_entries(kwvals[0], URING_ENTRIES, "entries");
+	unsigned int completion_entries = initialize_entries(kwvals[1], entries * URING_COMPLETION_FACTOR, "completion_entries");
+	
+	if (completion_entries < entries) {
+		rb_raise(rb_eArgError, "completion_entries must be at least entries!");
+	}
+	
+	int sqpoll = kwvals[2] != Qundef && RTEST(kwvals[2]);
+	
+	int sq_thread_cpu = -1;
+	if (kwvals[3] != Qundef && !NIL_P(kwvals[3])) {
+		sq_thread_cpu = NUM2INT(kwvals[3]);
+		
+		if (sq_thread_cpu < 0) {
+			rb_raise(rb_eArgError, "sq_thread_cpu must be at least 0!");
+		}
+	}
+	
+	unsigned int sq_thread_idle = 0;
+	if (kwvals[4] != Qundef && !NIL_P(kwvals[4])) {
+		double idle = NUM2DBL(kwvals[4]);
+		
+		if (idle < 0) {
+			rb_raise(rb_eArgError, "sq_thread_idle must be at least 0!");
+		}
+		
+		// The kernel uses milliseconds, and 0 would select its default:
+		sq_thread_idle = idle * 1000.0;
+		if (sq_thread_idle == 0) sq_thread_idle = 1;
+	}
+	
+	IO_Event_Selector_initialize(&selector->backend, self, loop);
+	
+	unsigned int flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+	// IORING_SETUP_SINGLE_ISSUER (kernel 6.0+): only the owner thread submits SQEs.
+	// Safe here because wakeup() uses eventfd (no ring access from other threads).
+#ifdef IORING_SETUP_SINGLE_ISSUER
+	flags |= IORING_SETUP_SINGLE_ISSUER;
+#endif
+	// IORING_SETUP_DEFER_TASKRUN (kernel 6.1+, requires SINGLE_ISSUER): defer io_uring
+	// task work to the application thread rather than a kernel thread, reducing
 	// cross-CPU signaling overhead.
 #ifdef IORING_SETUP_DEFER_TASKRUN
 	flags |= IORING_SETUP_DEFER_TASKRUN;
@@ -295,16 +1027,33 @@ VALUE IO_Event_Selector_URing_initialize(VALUE self, VALUE loop) {
 	flags |= IORING_SETUP_SUBMIT_ALL;
 #endif
 	
-	int result = io_uring_queue_init(URING_ENTRIES, &selector->ring, flags);
+	int result = -EINVAL;
 	
-#ifdef IORING_SETUP_SUBMIT_ALL
-	if (result == -EINVAL) {
-		// IORING_SETUP_SUBMIT_ALL was added in Linux 5.18; retry without it.
-		if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_initialize: no IORING_SETUP_SUBMIT_ALL\n");
-		flags &= ~IORING_SETUP_SUBMIT_ALL;
-		result = io_uring_queue_init(URING_ENTRIES, &selector->ring, flags);
+	if (sqpoll) {
+		struct io_uring_params params = {
+			.flags = sqpoll_flags(flags),
+			.cq_entries = completion_entries,
+			.sq_thread_idle = sq_thread_idle,
+		};
+		
+		if (sq_thread_cpu >= 0) {
+			params.flags |= IORING_SETUP_SQ_AFF;
+			params.sq_thread_cpu = sq_thread_cpu;
+		}
+		
+		result = initialize_ring(&selector->ring, entries, &params);
+		
+		if (DEBUG && result < 0) fprintf(stderr, "IO_Event_Selector_URing_initialize: IORING_SETUP_SQPOLL failed: %s\n", strerror(-result));
+	}
+	
+	if (result < 0) {
+		struct io_uring_params params = {
+			.flags = flags,
+			.cq_entries = completion_entries,
+		};
+		
+		result = initialize_ring(&selector->ring, entries, &params);
 	}
-#endif
 	
 	if (result < 0) {
 		rb_syserr_fail(-result, "IO_Event_Selector_URing_initialize:io_uring_queue_init");
@@ -343,6 +1092,49 @@ VALUE IO_Event_Selector_URing_idle_duration(VALUE self) {
 	return DBL2NUM(duration);
 }
 
+// Runtime statistics of the selector. In addition to the common counters (see `IO_Event_Selector_Statistics`), these describe how well the ring is sized for the workload:
+//
+// - `submission_entries`/`completion_entries`: The actual size of each queue.
+// - `submission_queue_full`: How many times the submission queue was full and had to be submitted early.
+// - `completion_queue_overflow`: How many times completions didn't fit in the completion queue and were held by the kernel.
+// - `completion_queue_dropped`: How many completions the kernel dropped entirely.
+// - `submissions`/`submitted_entries`: How many times entries were submitted to the kernel, and how many entries in total. The ratio is the average batch size per submission. With SQPOLL, entries are published to the kernel thread without a system call.
+// - `sqpoll_wakeups`: How many submissions had to wake up the SQPOLL kernel thread (only present with SQPOLL).
+// - `optimistic_hits`/`optimistic_misses`: How many optimistic reads and writes completed directly, and how many would have blocked and were submitted to the ring instead.
+VALUE IO_Event_Selector_URing_statistics(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	VALUE statistics = IO_Event_Selector_statistics(&selector->backend, rb_hash_new());
+	
+	if (selector->ring.ring_fd >= 0 && selector->owner == getpid()) {
+		rb_hash_aset(statistics, ID2SYM(rb_intern("submission_entries")), RB_UINT2NUM(selector->ring.sq.ring_entries));
+		rb_hash_aset(statistics, ID2SYM(rb_intern("completion_entries")), RB_UINT2NUM(selector->ring.cq.ring_entries));
+		rb_hash_aset(statistics, ID2SYM(rb_intern("completion_queue_dropped")), RB_UINT2NUM(__atomic_load_n(selector->ring.cq.koverflow, __ATOMIC_RELAXED)));
+	}
+	
+	rb_hash_aset(statistics, ID2SYM(rb_intern("submission_queue_full")), SIZET2NUM(selector->submission_queue_full));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("completion_queue_overflow")), SIZET2NUM(selector->completion_queue_overflow));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("submissions")), SIZET2NUM(selector->submissions));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("submitted_entries")), SIZET2NUM(selector->submitted_entries));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("optimistic_hits")), SIZET2NUM(selector->optimistic_hits));
+	rb_hash_aset(statistics, ID2SYM(rb_intern("optimistic_misses")), SIZET2NUM(selector->optimistic_misses));
+	
+	if (selector->ring.flags & IORING_SETUP_SQPOLL) {
+		rb_hash_aset(statistics, ID2SYM(rb_intern("sqpoll_wakeups")), SIZET2NUM(selector->sqpoll_wakeups));
+	}
+	
+	return statistics;
+}
+
+// Whether a kernel thread is polling the submission queue. This may be false even if `sqpoll: true` was requested, if the kernel refused to create the thread.
+VALUE IO_Event_Selector_URing_sqpoll_p(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return (selector->ring.flags & IORING_SETUP_SQPOLL) ? Qtrue : Qfalse;
+}
+
 VALUE IO_Event_Selector_URing_close(VALUE self) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
@@ -405,7 +1197,7 @@ VALUE IO_Event_Selector_URing_ready_p(VALUE self) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	return selector->backend.ready ? Qtrue : Qfalse;
+	return IO_Event_Selector_ready_p(&selector->backend) ? Qtrue : Qfalse;
 }
 
 #pragma mark - Submission Queue
@@ -436,14 +1228,44 @@ void IO_Event_Selector_URing_dump_completion_queue(struct IO_Event_Selector_URin
 	}
 }
 
+// With SQPOLL, the kernel thread consumes the submission queue, so submitting only needs to publish the new entries. If the thread has gone to sleep it sets `IORING_SQ_NEED_WAKEUP`, and `io_uring_submit` enters the kernel to wake it up. We don't wait for the thread to consume the entries.
+static
+int io_uring_submit_sqpoll(struct IO_Event_Selector_URing *selector) {
+	struct io_uring *ring = &selector->ring;
+	
+	int sleeping = __atomic_load_n(ring->sq.kflags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP;
+	
+	int result = io_uring_submit(ring);
+	
+	if (result > 0) {
+		selector->submissions += 1;
+		selector->submitted_entries += result;
+		
+		if (sleeping) selector->sqpoll_wakeups += 1;
+	} else if (result < 0 && result != -EBUSY && result != -EAGAIN) {
+		rb_syserr_fail(-result, "io_uring_submit_sqpoll:io_uring_submit");
+	}
+	
+	return 0;
+}
+
 // Flush the submission queue, optionally yielding if unsuccessful.
 static
 int io_uring_submit_all(struct IO_Event_Selector_URing *selector, bool yield) {
 	struct io_uring *ring = &selector->ring;
+	
+	if (ring->flags & IORING_SETUP_SQPOLL) {
+		return io_uring_submit_sqpoll(selector);
+	}
 
 	while (io_uring_sq_ready(ring) > 0) {
 		int result = io_uring_submit(&selector->ring);
 		
+		if (result > 0) {
+			selector->submissions += 1;
+			selector->submitted_entries += result;
+		}
+		
 		if (result == -EBUSY || result == -EAGAIN) {
 			if (yield) IO_Event_Selector_yield(&selector->backend);
 		} else if (result < 0) {
@@ -478,7 +1300,7 @@ int io_uring_submit_now(struct IO_Event_Selector_URing *selector) {
 	return io_uring_submit_all(selector, true);
 }
 
-// Submit a pending operation. This does not submit the operation immediately, but instead defers it to the next call to `io_uring_submit_flush` or `io_uring_submit_now`. This is useful for operations that are not urgent, but should be used with care as it can lead to a deadlock if the submission queue is not flushed.
+// Submit a pending operation. This does not submit the operation immediately, but instead defers it to the next call to `io_uring_submit_flush` or `io_uring_submit_now`. Operations queued by fibers are flushed together by `select` before it processes completions or blocks, so many fibers can share a single `io_uring_enter`. Operations which must reach the kernel before returning (e.g. cancellations and closes) should use `io_uring_submit_now` instead.
 static
 void io_uring_submit_pending(struct IO_Event_Selector_URing *selector) {
 	if (DEBUG) {
@@ -491,84 +1313,275 @@ struct io_uring_sqe * io_get_sqe(struct IO_Event_Selector_URing *selector) {
 	struct io_uring_sqe *sqe = io_uring_get_sqe(&selector->ring);
 	
 	while (sqe == NULL) {
+		selector->submission_queue_full += 1;
+		
 		// The submit queue is full, we need to drain it:	
 		io_uring_submit_now(selector);
 		
+		// With SQPOLL, the kernel thread may not have consumed the submitted entries yet:
+		if (selector->ring.flags & IORING_SETUP_SQPOLL) {
+			io_uring_sqring_wait(&selector->ring);
+		}
+		
 		sqe = io_uring_get_sqe(&selector->ring);
 	}
 
 	return sqe;
 }
 
-#pragma mark - Process.wait
+#pragma mark - Timeouts
 
-#ifdef IO_EVENT_SELECTOR_URING_USE_WAITID
-// Translate a Ruby/`waitpid`-style pid into the `waitid(2)` idtype and id, mirroring the semantics of `waitpid(2)`:
-//
-//   pid == -1  -> any child                                  (P_ALL)
-//   pid ==  0  -> any child in the caller's process group    (P_PGID, id 0; Linux >= 5.4)
-//   pid <  -1  -> any child in process group |pid|           (P_PGID)
-//   pid >   0  -> the specific child                         (P_PID)
-//
-static inline idtype_t process_waitid_type(pid_t pid, id_t *id) {
-	if (pid == -1) {
-		*id = 0;
-		return P_ALL;
-	} else if (pid == 0) {
-		*id = 0;
-		return P_PGID;
-	} else if (pid < -1) {
-		*id = (id_t)(-pid);
-		return P_PGID;
-	} else {
-		*id = (id_t)pid;
-		return P_PID;
-	}
-}
-#endif
+static struct __kernel_timespec * make_timeout(VALUE duration, struct __kernel_timespec *storage);
 
-struct process_wait_arguments {
-	struct IO_Event_Selector_URing *selector;
-	struct IO_Event_Selector_URing_Waiting *waiting;
+// Convert a relative timeout (in seconds) into an absolute `CLOCK_MONOTONIC` deadline, suitable for `IORING_TIMEOUT_ABS`. Using an absolute deadline means that operations which are retried (e.g. partial reads) share a single deadline rather than each getting the full duration.
+static
+struct __kernel_timespec * make_deadline(VALUE duration, struct __kernel_timespec *storage) {
+	struct __kernel_timespec timeout;
 	
-	pid_t pid;
-	int flags;
+	if (make_timeout(duration, &timeout) == NULL) {
+		return NULL;
+	}
 	
-#ifdef IO_EVENT_SELECTOR_URING_USE_WAITID
-	siginfo_t siginfo;
-#else
-	int descriptor;
-#endif
-};
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	storage->tv_sec = now.tv_sec + timeout.tv_sec;
+	storage->tv_nsec = now.tv_nsec + timeout.tv_nsec;
+	
+	if (storage->tv_nsec >= 1000000000L) {
+		storage->tv_sec += 1;
+		storage->tv_nsec -= 1000000000L;
+	}
+	
+	return storage;
+}
 
-#if defined(IO_EVENT_SELECTOR_URING_USE_WAITID) && defined(HAVE_RB_PROCESS_STATUS_FOR)
-static inline int process_wait_status_exited(int exit_status) {
-	return (exit_status & 0xff) << 8;
+// Get a submission queue entry for an operation which may be followed by a linked timeout. Both entries must be submitted together, so we ensure there is space for both before returning the first.
+static
+struct io_uring_sqe * io_get_sqe_linked(struct IO_Event_Selector_URing *selector, struct __kernel_timespec *deadline) {
+	if (deadline) {
+		while (io_uring_sq_space_left(&selector->ring) < 2) {
+			io_uring_submit_now(selector);
+		}
+	}
+	
+	return io_get_sqe(selector);
 }
 
-static inline int process_wait_status_signaled(int term_signal) {
-	return term_signal & 0x7f;
+// Link a timeout to the given operation, so that the kernel cancels it if it does not complete before the deadline. In that case, the operation completes with `-ECANCELED` and the timeout itself completes with `-ETIME`, which is ignored (it has no user data). The deadline must remain valid until the entries are submitted.
+static
+void io_link_deadline(struct IO_Event_Selector_URing *selector, struct io_uring_sqe *sqe, struct __kernel_timespec *deadline) {
+	if (deadline == NULL) return;
+	
+	sqe->flags |= IOSQE_IO_LINK;
+	
+	struct io_uring_sqe *timeout_sqe = io_get_sqe(selector);
+	io_uring_prep_link_timeout(timeout_sqe, deadline, IORING_TIMEOUT_ABS);
+	io_uring_sqe_set_data(timeout_sqe, NULL);
 }
 
-static inline int process_wait_status_from_siginfo(const siginfo_t *siginfo) {
-	switch (siginfo->si_code) {
-		case CLD_EXITED:
-			return process_wait_status_exited(siginfo->si_status);
-		case CLD_KILLED:
-			return process_wait_status_signaled(siginfo->si_status);
-		case CLD_DUMPED:
-			return process_wait_status_signaled(siginfo->si_status) | 0x80;
-		default:
-			return 0;
+// If an operation with a deadline was cancelled, it was cancelled by the linked timeout. Cancellation due to an exception happens in the `*_ensure` functions, which don't inspect the result.
+static inline
+int io_deadline_result(struct __kernel_timespec *deadline, int result) {
+	if (deadline && result == -ECANCELED) {
+		return -ETIMEDOUT;
 	}
+	
+	return result;
+}
+
+#pragma mark - Fixed Files
+
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+static inline
+struct IO_Event_Selector_URing_File * IO_Event_Selector_URing_File_find(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	if (descriptor < 0 || (size_t)descriptor >= selector->files.limit) return NULL;
+	
+	struct IO_Event_Selector_URing_File *file = selector->files.base[descriptor];
+	if (file && file->io) return file;
+	
+	return NULL;
 }
-#endif
 
 static
-VALUE process_wait_transfer(VALUE _arguments) {
-	struct process_wait_arguments *arguments = (struct process_wait_arguments *)_arguments;
+void IO_Event_Selector_URing_File_unregister(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	struct IO_Event_Selector_URing_File *file = IO_Event_Selector_URing_File_find(selector, descriptor);
+	if (file == NULL) return;
 	
-	IO_Event_Selector_loop_yield(&arguments->selector->backend);
+	// Any operations which are still in flight retain their own reference to the file:
+	int empty = -1;
+	io_uring_register_files_update(&selector->ring, descriptor, &empty, 1);
+	
+	RB_OBJ_WRITE(selector->backend.self, &file->io, 0);
+}
+#endif
+
+// Use the registered file for the given descriptor, if there is one. Since the descriptor occupies the slot of the same index, only the flag needs to be set.
+static inline
+void io_set_file(struct IO_Event_Selector_URing *selector, struct io_uring_sqe *sqe, int descriptor)
+{
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	if (IO_Event_Selector_URing_File_find(selector, descriptor)) {
+		sqe->flags |= IOSQE_FIXED_FILE;
+	}
+#endif
+}
+
+// Get the descriptor for the given IO. If the descriptor is registered for a different IO, it must have been closed without `io_close` and reused, so the stale registration is dropped rather than redirecting operations to the previous file.
+static inline
+int IO_Event_Selector_URing_io_descriptor(struct IO_Event_Selector_URing *selector, VALUE io)
+{
+	int descriptor = IO_Event_Selector_io_descriptor(io);
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	struct IO_Event_Selector_URing_File *file = IO_Event_Selector_URing_File_find(selector, descriptor);
+	
+	if (file && file->io != io) {
+		IO_Event_Selector_URing_File_unregister(selector, descriptor);
+	}
+#endif
+	
+	return descriptor;
+}
+
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+// The fixed file table can't be resized without waiting for every operation that uses it, so it is allocated once, covering every descriptor the process may open (up to `URING_FILES_MAXIMUM`). Only the selector's own bookkeeping grows lazily.
+static
+void IO_Event_Selector_URing_files_allocate(struct IO_Event_Selector_URing *selector)
+{
+	unsigned limit = URING_FILES_MAXIMUM;
+	
+	struct rlimit rlimit;
+	if (getrlimit(RLIMIT_NOFILE, &rlimit) == 0 && rlimit.rlim_cur != RLIM_INFINITY && rlimit.rlim_cur < limit) {
+		limit = (unsigned)rlimit.rlim_cur;
+	}
+	
+	int result = io_uring_register_files_sparse(&selector->ring, limit);
+	if (result < 0) {
+		rb_syserr_fail(-result, "IO_Event_Selector_URing_register:io_uring_register_files_sparse");
+	}
+	
+	selector->files_limit = limit;
+}
+
+// Register the IO in the fixed file table, so that operations on it don't need to look up the file for every request. The table holds a reference to the file, so a registered IO must be closed via `io_close` (or unregistered first), otherwise the underlying file remains open.
+//
+// Returns true if the IO was registered, or false if its descriptor is beyond the size of the table.
+VALUE IO_Event_Selector_URing_register(VALUE self, VALUE io) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	
+	if (selector->files_limit == 0) {
+		IO_Event_Selector_URing_files_allocate(selector);
+	}
+	
+	if ((unsigned)descriptor >= selector->files_limit) {
+		return Qfalse;
+	}
+	
+	struct IO_Event_Selector_URing_File *file = IO_Event_Array_lookup(&selector->files, descriptor);
+	
+	if (!file->io) {
+		int result = io_uring_register_files_update(&selector->ring, descriptor, &descriptor, 1);
+		if (result < 0) {
+			rb_syserr_fail(-result, "IO_Event_Selector_URing_register:io_uring_register_files_update");
+		}
+		
+		RB_OBJ_WRITE(self, &file->io, io);
+	}
+	
+	return Qtrue;
+}
+
+// Remove the IO from the fixed file table. Returns true if it was registered.
+VALUE IO_Event_Selector_URing_unregister(VALUE self, VALUE io) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	
+	if (IO_Event_Selector_URing_File_find(selector, descriptor)) {
+		IO_Event_Selector_URing_File_unregister(selector, descriptor);
+		return Qtrue;
+	}
+	
+	return Qfalse;
+}
+#endif
+
+#pragma mark - Process.wait
+
+#ifdef IO_EVENT_SELECTOR_URING_USE_WAITID
+// Translate a Ruby/`waitpid`-style pid into the `waitid(2)` idtype and id, mirroring the semantics of `waitpid(2)`:
+//
+//   pid == -1  -> any child                                  (P_ALL)
+//   pid ==  0  -> any child in the caller's process group    (P_PGID, id 0; Linux >= 5.4)
+//   pid <  -1  -> any child in process group |pid|           (P_PGID)
+//   pid >   0  -> the specific child                         (P_PID)
+//
+static inline idtype_t process_waitid_type(pid_t pid, id_t *id) {
+	if (pid == -1) {
+		*id = 0;
+		return P_ALL;
+	} else if (pid == 0) {
+		*id = 0;
+		return P_PGID;
+	} else if (pid < -1) {
+		*id = (id_t)(-pid);
+		return P_PGID;
+	} else {
+		*id = (id_t)pid;
+		return P_PID;
+	}
+}
+#endif
+
+struct process_wait_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Waiting *waiting;
+	
+	pid_t pid;
+	int flags;
+	
+#ifdef IO_EVENT_SELECTOR_URING_USE_WAITID
+	siginfo_t siginfo;
+#else
+	int descriptor;
+#endif
+};
+
+#if defined(IO_EVENT_SELECTOR_URING_USE_WAITID) && defined(HAVE_RB_PROCESS_STATUS_FOR)
+static inline int process_wait_status_exited(int exit_status) {
+	return (exit_status & 0xff) << 8;
+}
+
+static inline int process_wait_status_signaled(int term_signal) {
+	return term_signal & 0x7f;
+}
+
+static inline int process_wait_status_from_siginfo(const siginfo_t *siginfo) {
+	switch (siginfo->si_code) {
+		case CLD_EXITED:
+			return process_wait_status_exited(siginfo->si_status);
+		case CLD_KILLED:
+			return process_wait_status_signaled(siginfo->si_status);
+		case CLD_DUMPED:
+			return process_wait_status_signaled(siginfo->si_status) | 0x80;
+		default:
+			return 0;
+	}
+}
+#endif
+
+static
+VALUE process_wait_transfer(VALUE _arguments) {
+	struct process_wait_arguments *arguments = (struct process_wait_arguments *)_arguments;
+	
+	IO_Event_Selector_loop_yield(&arguments->selector->backend);
 	
 #ifdef IO_EVENT_SELECTOR_URING_USE_WAITID
 	int32_t result = arguments->waiting->result;
@@ -708,6 +1721,7 @@ struct io_wait_arguments {
 	struct IO_Event_Selector_URing *selector;
 	struct IO_Event_Selector_URing_Waiting *waiting;
 	short flags;
+	struct __kernel_timespec *deadline;
 };
 
 static
@@ -716,6 +1730,7 @@ VALUE io_wait_ensure(VALUE _arguments) {
 	
 	// If the operation is still in progress, cancel it:
 	if (arguments->waiting->completion) {
+		arguments->selector->backend.statistics.cancellations += 1;
 		if (DEBUG) fprintf(stderr, "io_wait_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
 		struct io_uring_sqe *sqe = io_get_sqe(arguments->selector);
 		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
@@ -737,8 +1752,11 @@ VALUE io_wait_transfer(VALUE _arguments) {
 	
 	if (DEBUG) fprintf(stderr, "io_wait_transfer:waiting=%p, result=%d\n", (void*)arguments->waiting, arguments->waiting->result);
 	
-	int32_t result = arguments->waiting->result;
-	if (result < 0) {
+	int32_t result = io_deadline_result(arguments->deadline, arguments->waiting->result);
+	if (result == -ETIMEDOUT) {
+		// The linked timeout expired before the descriptor became ready:
+		return Qfalse;
+	} else if (result < 0) {
 		rb_syserr_fail(-result, "io_wait_transfer:io_uring_poll_add");
 	} else if (result > 0) {
 		// We explicitly filter the resulting events based on the requested events.
@@ -749,435 +1767,2099 @@ VALUE io_wait_transfer(VALUE _arguments) {
 	}
 };
 
-VALUE IO_Event_Selector_URing_io_wait(VALUE self, VALUE fiber, VALUE io, VALUE events) {
-	struct IO_Event_Selector_URing *selector = NULL;
-	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
-	
-	int descriptor = IO_Event_Selector_io_descriptor(io);
-	
-	short flags = poll_flags_from_events(NUM2INT(events));
-	
-	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_io_wait:io_uring_prep_poll_add(descriptor=%d, flags=%d, fiber=%p)\n", descriptor, flags, (void*)fiber);
-	
-	struct IO_Event_Selector_URing_Waiting waiting = {
-		.fiber = fiber,
-	};
-	
-	RB_OBJ_WRITTEN(self, Qundef, fiber);
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+
+static inline
+struct IO_Event_Selector_URing_Poller * IO_Event_Selector_URing_Poller_find(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	if (descriptor < 0 || (size_t)descriptor >= selector->pollers.limit) return NULL;
 	
-	struct IO_Event_Selector_URing_Completion *completion = IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	return selector->pollers.base[descriptor];
+}
+
+static inline
+void *IO_Event_Selector_URing_Poller_user_data(struct IO_Event_Selector_URing_Poller *poller)
+{
+	return (void*)((uintptr_t)poller | URING_USER_DATA_POLLER);
+}
+
+static
+void IO_Event_Selector_URing_Poller_arm(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Poller *poller, int descriptor, short flags)
+{
+	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_Poller_arm:io_uring_prep_poll_multishot(descriptor=%d, flags=%d)\n", descriptor, flags);
 	
 	struct io_uring_sqe *sqe = io_get_sqe(selector);
-	io_uring_prep_poll_add(sqe, descriptor, flags);
-	io_uring_sqe_set_data(sqe, completion);
+	io_uring_prep_poll_multishot(sqe, descriptor, flags);
+	io_set_file(selector, sqe, descriptor);
+	io_uring_sqe_set_data(sqe, IO_Event_Selector_URing_Poller_user_data(poller));
 	// If we are going to wait, we assume that we are waiting for a while:
 	io_uring_submit_pending(selector);
 	
-	struct io_wait_arguments io_wait_arguments = {
-		.selector = selector,
-		.waiting = &waiting,
-		.flags = flags
-	};
-	
-	return rb_ensure(io_wait_transfer, (VALUE)&io_wait_arguments, io_wait_ensure, (VALUE)&io_wait_arguments);
+	poller->descriptor = descriptor;
+	poller->registered = flags;
 }
 
-#ifdef HAVE_RUBY_IO_BUFFER_H
-
-#pragma mark - IO#read
-
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,16,0)
-static inline off_t io_seekable(int descriptor) {
-	return -1;
-}
-#else
-#warning Upgrade your kernel to 5.16+! io_uring bugs prevent efficient io_read/io_write hooks.
-static inline off_t io_seekable(int descriptor)
+// Cancel the armed multishot poll. The descriptor may be reused (or registered again) before the final completion arrives, so the poller is detached from the descriptor and freed by that completion.
+static
+void IO_Event_Selector_URing_Poller_detach(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Poller *poller, int descriptor)
 {
-	if (lseek(descriptor, 0, SEEK_CUR) == -1) {
-		return 0;
-	} else {
-		return -1;
-	}
+	struct io_uring_sqe *sqe = io_get_sqe(selector);
+	io_uring_prep_cancel(sqe, IO_Event_Selector_URing_Poller_user_data(poller), 0);
+	io_uring_sqe_set_data(sqe, NULL);
+	
+	poller->io = 0;
+	poller->orphaned = 1;
+	IO_Event_List_append(&selector->orphaned_pollers, &poller->list);
+	selector->pollers.base[descriptor] = NULL;
 }
-#endif
-
-#pragma mark - IO#read
-
-struct io_read_arguments {
-	struct IO_Event_Selector_URing *selector;
-	struct IO_Event_Selector_URing_Waiting *waiting;
-	int descriptor;
-	off_t offset;
-	char *buffer;
-	size_t length;
-};
 
-static VALUE
-io_read_submit(VALUE _arguments)
+// Replace an armed poller with a fresh one, moving any waiting fibers across. This is required when the set of events changes, or the descriptor is reused by a different IO.
+static
+struct IO_Event_Selector_URing_Poller * IO_Event_Selector_URing_Poller_replace(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Poller *poller, int descriptor)
 {
-	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
-	struct IO_Event_Selector_URing *selector = arguments->selector;
+	if (!poller->registered) return poller;
 	
-	if (DEBUG) fprintf(stderr, "io_read_submit:io_uring_prep_read(waiting=%p, completion=%p, descriptor=%d, buffer=%p, length=%ld)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->buffer, arguments->length);
+	VALUE io = poller->io;
+	IO_Event_Selector_URing_Poller_detach(selector, poller, descriptor);
 	
-	struct io_uring_sqe *sqe = io_get_sqe(selector);
-	io_uring_prep_read(sqe, arguments->descriptor, arguments->buffer, arguments->length, arguments->offset);
-	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
-	io_uring_submit_now(selector);
+	struct IO_Event_Selector_URing_Poller *replacement = IO_Event_Array_lookup(&selector->pollers, descriptor);
 	
-	IO_Event_Selector_loop_yield(&selector->backend);
+	while (!IO_Event_List_empty(&poller->waiting)) {
+		struct IO_Event_List *node = poller->waiting.tail;
+		IO_Event_List_pop(node);
+		IO_Event_List_append(&replacement->waiting, node);
+	}
 	
-	return RB_INT2NUM(arguments->waiting->result);
+	RB_OBJ_WRITE(selector->backend.self, &replacement->io, io);
+	
+	return replacement;
 }
 
-static VALUE
-io_read_ensure(VALUE _arguments)
+// The descriptor is being closed: fail any waiting fibers and cancel the armed multishot poll, which would otherwise hold a reference to the file.
+static
+void IO_Event_Selector_URing_Poller_close(struct IO_Event_Selector_URing *selector, int descriptor)
 {
-	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
-	struct IO_Event_Selector_URing *selector = arguments->selector;
+	struct IO_Event_Selector_URing_Poller *poller = IO_Event_Selector_URing_Poller_find(selector, descriptor);
+	if (poller == NULL) return;
 	
-	// If the operation is still in progress, cancel it:
-	if (arguments->waiting->completion) {
-		if (DEBUG) fprintf(stderr, "io_read_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
-		struct io_uring_sqe *sqe = io_get_sqe(selector);
-		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
-		io_uring_sqe_set_data(sqe, NULL);
-		io_uring_submit_now(selector);
+	while (!IO_Event_List_empty(&poller->waiting)) {
+		struct IO_Event_Selector_URing_Poller_Waiting *waiting = (struct IO_Event_Selector_URing_Poller_Waiting *)poller->waiting.tail;
+		IO_Event_List_pop(&waiting->list);
+		
+		waiting->result = -EBADF;
+		waiting->ready = 1;
+		
+		IO_Event_Selector_ready_push(&selector->backend, waiting->fiber);
 	}
 	
-	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
+	if (poller->registered) {
+		IO_Event_Selector_URing_Poller_detach(selector, poller, descriptor);
+		io_uring_submit_now(selector);
+	} else {
+		RB_OBJ_WRITE(selector->backend.self, &poller->io, 0);
+		poller->ready = 0;
+	}
+}
+
+// The multishot poll holds a reference to the file, which would keep it open after the IO is closed without `io_close` (which older versions of Ruby don't call). So it only stays armed while fibers are waiting, and is cancelled once the last one stops waiting. Fibers which wait again as soon as they are resumed keep it armed.
+static
+void IO_Event_Selector_URing_Poller_idle(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Poller *poller)
+{
+	if (poller->orphaned || !IO_Event_List_empty(&poller->waiting)) return;
 	
-	return Qnil;
+	if (poller->registered) {
+		IO_Event_Selector_URing_Poller_detach(selector, poller, poller->descriptor);
+	} else {
+		RB_OBJ_WRITE(selector->backend.self, &poller->io, 0);
+		poller->ready = 0;
+	}
 }
 
-static int
-io_read(struct IO_Event_Selector_URing *selector, VALUE fiber, int descriptor, char *buffer, size_t length, off_t offset)
+// Process a completion of the multishot poll for the given poller.
+static
+void IO_Event_Selector_URing_Poller_complete(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Poller *poller, int32_t result, uint32_t flags)
 {
-	struct IO_Event_Selector_URing_Waiting waiting = {
-		.fiber = fiber,
-	};
+	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_Poller_complete(result=%d, flags=%u)\n", result, flags);
 	
-	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	if (poller->orphaned) {
+		if (!(flags & IORING_CQE_F_MORE)) {
+			IO_Event_List_pop(&poller->list);
+			IO_Event_Selector_URing_Poller_free(poller);
+			xfree(poller);
+		}
+		
+		return;
+	}
 	
-	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	// If the kernel is not going to produce further completions (e.g. the completion queue overflowed), the poll must be armed again:
+	if (!(flags & IORING_CQE_F_MORE)) {
+		poller->registered = 0;
+	}
 	
-	struct io_read_arguments io_read_arguments = {
-		.selector = selector,
-		.waiting = &waiting,
-		.descriptor = descriptor,
-		.offset = offset,
-		.buffer = buffer,
-		.length = length
-	};
+	// Fibers which are ready are moved to a separate list before any of them are resumed, since resuming a fiber may replace or close this poller:
+	struct IO_Event_List ready;
+	IO_Event_List_initialize(&ready);
 	
-	return RB_NUM2INT(
-		rb_ensure(io_read_submit, (VALUE)&io_read_arguments, io_read_ensure, (VALUE)&io_read_arguments)
+	short unmatched = result > 0 ? result : 0;
+	short remaining = 0;
+	
+	struct IO_Event_List *node = poller->waiting.tail;
+	while (node != &poller->waiting) {
+		struct IO_Event_Selector_URing_Poller_Waiting *waiting = (struct IO_Event_Selector_URing_Poller_Waiting *)node;
+		node = node->tail;
+		
+		if (result < 0) {
+			waiting->result = result;
+		} else if (waiting->flags & result) {
+			waiting->result = waiting->flags & result;
+			unmatched &= ~waiting->flags;
+		} else {
+			remaining |= waiting->flags;
+			continue;
+		}
+		
+		waiting->ready = 1;
+		IO_Event_List_pop(&waiting->list);
+		IO_Event_List_append(&ready, &waiting->list);
+	}
+	
+	// Remember readiness which nobody was waiting for, since the multishot poll won't report it again until the state changes:
+	poller->ready |= unmatched;
+	
+	if (!poller->registered && remaining) {
+		IO_Event_Selector_URing_Poller_arm(selector, poller, poller->descriptor, remaining);
+	}
+	
+	while (!IO_Event_List_empty(&ready)) {
+		struct IO_Event_Selector_URing_Poller_Waiting *waiting = (struct IO_Event_Selector_URing_Poller_Waiting *)ready.tail;
+		IO_Event_List_pop(&waiting->list);
+		
+		IO_Event_Selector_loop_resume(&selector->backend, waiting->fiber, 0, NULL);
+	}
+	
+	IO_Event_Selector_URing_Poller_idle(selector, poller);
+}
+
+struct io_wait_multishot_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Poller_Waiting *waiting;
+	int descriptor;
+};
+
+static
+VALUE io_wait_multishot_transfer(VALUE _arguments) {
+	struct io_wait_multishot_arguments *arguments = (struct io_wait_multishot_arguments *)_arguments;
+	
+	while (!arguments->waiting->ready) {
+		IO_Event_Selector_loop_yield(&arguments->selector->backend);
+	}
+	
+	return Qnil;
+}
+
+static
+VALUE io_wait_multishot_ensure(VALUE _arguments) {
+	struct io_wait_multishot_arguments *arguments = (struct io_wait_multishot_arguments *)_arguments;
+	
+	// If we were interrupted, stop waiting:
+	IO_Event_List_free(&arguments->waiting->list);
+	
+	if (!arguments->waiting->ready) {
+		struct IO_Event_Selector_URing_Poller *poller = IO_Event_Selector_URing_Poller_find(arguments->selector, arguments->descriptor);
+		
+		if (poller) {
+			IO_Event_Selector_URing_Poller_idle(arguments->selector, poller);
+		}
+	}
+	
+	return Qnil;
+}
+
+// Wait for events using a multishot poll which remains armed across calls, so repeated waits on the same descriptor don't need any submissions while fibers keep waiting on it, until the set of events changes.
+//
+// The multishot poll only reports changes in readiness, so readiness which is reported while no fiber is waiting is remembered and consumed by the next wait. This is sufficient provided the caller waits only after an operation would block (which is how Ruby's `IO` uses the scheduler).
+static
+VALUE io_wait_multishot(VALUE self, struct IO_Event_Selector_URing *selector, VALUE fiber, VALUE io, short flags) {
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	struct IO_Event_Selector_URing_Poller *poller = IO_Event_Array_lookup(&selector->pollers, descriptor);
+	
+	if (poller->io != io) {
+		// The IO has changed, so any armed poll may refer to a different file:
+		poller = IO_Event_Selector_URing_Poller_replace(selector, poller, descriptor);
+		poller->ready = 0;
+		RB_OBJ_WRITE(self, &poller->io, io);
+	}
+	
+	if ((poller->registered & flags) != flags) {
+		short registered = poller->registered | flags;
+		
+		poller = IO_Event_Selector_URing_Poller_replace(selector, poller, descriptor);
+		IO_Event_Selector_URing_Poller_arm(selector, poller, descriptor, registered);
+	}
+	
+	short ready = poller->ready & flags;
+	if (ready) {
+		// Hang ups and errors persist, so they are not consumed:
+		poller->ready &= ~(ready & ~(POLLHUP|POLLERR));
+		IO_Event_Selector_URing_Poller_idle(selector, poller);
+		
+		return RB_INT2NUM(events_from_poll_flags(ready));
+	}
+	
+	struct IO_Event_Selector_URing_Poller_Waiting waiting = {
+		.fiber = fiber,
+		.flags = flags,
+	};
+	
+	RB_OBJ_WRITTEN(self, Qundef, fiber);
+	
+	IO_Event_List_append(&poller->waiting, &waiting.list);
+	
+	struct io_wait_multishot_arguments io_wait_multishot_arguments = {
+		.selector = selector,
+		.waiting = &waiting,
+		.descriptor = descriptor,
+	};
+	
+	rb_ensure(io_wait_multishot_transfer, (VALUE)&io_wait_multishot_arguments, io_wait_multishot_ensure, (VALUE)&io_wait_multishot_arguments);
+	
+	if (waiting.result < 0) {
+		rb_syserr_fail(-waiting.result, "io_wait_multishot:io_uring_prep_poll_multishot");
+	}
+	
+	return RB_INT2NUM(events_from_poll_flags(waiting.result));
+}
+
+#endif
+
+static
+VALUE io_wait(VALUE self, struct IO_Event_Selector_URing *selector, VALUE fiber, VALUE io, VALUE events, struct __kernel_timespec *deadline) {
+	short flags = poll_flags_from_events(NUM2INT(events));
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	// A linked timeout requires a dedicated poll, so waits with a deadline always use a one-shot poll:
+	if (selector->multishot_poll && deadline == NULL) {
+		return io_wait_multishot(self, selector, fiber, io, flags);
+	}
+#endif
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	
+	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_io_wait:io_uring_prep_poll_add(descriptor=%d, flags=%d, fiber=%p)\n", descriptor, flags, (void*)fiber);
+	
+	struct IO_Event_Selector_URing_Waiting waiting = {
+		.fiber = fiber,
+	};
+	
+	RB_OBJ_WRITTEN(self, Qundef, fiber);
+	
+	struct IO_Event_Selector_URing_Completion *completion = IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	
+	struct io_uring_sqe *sqe = io_get_sqe_linked(selector, deadline);
+	io_uring_prep_poll_add(sqe, descriptor, flags);
+	io_set_file(selector, sqe, descriptor);
+	io_uring_sqe_set_data(sqe, completion);
+	io_link_deadline(selector, sqe, deadline);
+	// If we are going to wait, we assume that we are waiting for a while:
+	io_uring_submit_pending(selector);
+	
+	struct io_wait_arguments io_wait_arguments = {
+		.selector = selector,
+		.waiting = &waiting,
+		.flags = flags,
+		.deadline = deadline,
+	};
+	
+	return rb_ensure(io_wait_transfer, (VALUE)&io_wait_arguments, io_wait_ensure, (VALUE)&io_wait_arguments);
+}
+
+VALUE IO_Event_Selector_URing_io_wait(VALUE self, VALUE fiber, VALUE io, VALUE events) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return io_wait(self, selector, fiber, io, events, NULL);
+}
+
+// `io_wait(fiber, io, events, timeout = nil)`: If a timeout is given, it is enforced by the kernel using a linked timeout, and `false` is returned if it expires.
+static VALUE IO_Event_Selector_URing_io_wait_compatible(int argc, VALUE *argv, VALUE self)
+{
+	rb_check_arity(argc, 3, 4);
+	
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	struct __kernel_timespec storage;
+	struct __kernel_timespec *deadline = NULL;
+	
+	if (argc == 4) {
+		deadline = make_deadline(argv[3], &storage);
+	}
+	
+	return io_wait(self, selector, argv[0], argv[1], argv[2], deadline);
+}
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+VALUE IO_Event_Selector_URing_multishot_poll(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return selector->multishot_poll ? Qtrue : Qfalse;
+}
+
+// Enable or disable persistent multishot polls for `io_wait`. Polls which are already armed remain armed until no fiber is waiting on them.
+VALUE IO_Event_Selector_URing_multishot_poll_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	selector->multishot_poll = RTEST(value);
+	
+	return value;
+}
+#endif
+
+static VALUE
+io_completion_yield(VALUE _selector)
+{
+	struct IO_Event_Selector_URing *selector = (struct IO_Event_Selector_URing*)_selector;
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return Qnil;
+}
+
+// Wait for a cancelled operation to complete, for operations which reference memory owned by the caller (or produce resources) until then. The fiber is resumed when the operation completes, and any further interruptions are deferred until it has.
+static void
+io_completion_wait(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Waiting *waiting)
+{
+	int state = 0;
+	VALUE exception = Qnil;
+	
+	while (waiting->completion) {
+		int result = 0;
+		rb_protect(io_completion_yield, (VALUE)selector, &result);
+		
+		if (result && !state) {
+			state = result;
+			exception = rb_errinfo();
+		}
+		
+		rb_set_errinfo(Qnil);
+	}
+	
+	if (state) {
+		rb_set_errinfo(exception);
+		rb_jump_tag(state);
+	}
+}
+
+#ifdef HAVE_RUBY_IO_BUFFER_H
+
+#pragma mark - IO#read
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,16,0)
+static inline off_t io_seekable(int descriptor) {
+	return -1;
+}
+#else
+#warning Upgrade your kernel to 5.16+! io_uring bugs prevent efficient io_read/io_write hooks.
+static inline off_t io_seekable(int descriptor)
+{
+	if (lseek(descriptor, 0, SEEK_CUR) == -1) {
+		return 0;
+	} else {
+		return -1;
+	}
+}
+#endif
+
+#pragma mark - Optimistic IO
+
+// Get the optimistic state for the given descriptor, or NULL if optimistic operations are disabled or not supported by the descriptor. Only sockets and pipes are tried, as they are the descriptors which often have data (or buffer space) available immediately.
+static
+struct IO_Event_Selector_URing_Descriptor * IO_Event_Selector_URing_Descriptor_optimistic(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	if (!selector->optimistic_io || descriptor < 0) return NULL;
+	
+	struct IO_Event_Selector_URing_Descriptor *state = IO_Event_Array_lookup(&selector->descriptors, descriptor);
+	
+	if (state->kind == IO_EVENT_SELECTOR_URING_DESCRIPTOR_UNKNOWN) {
+		struct stat stat;
+		state->kind = IO_EVENT_SELECTOR_URING_DESCRIPTOR_OTHER;
+		
+		if (fstat(descriptor, &stat) == 0) {
+			if (S_ISSOCK(stat.st_mode)) {
+				state->kind = IO_EVENT_SELECTOR_URING_DESCRIPTOR_SOCKET;
+			}
+#ifdef IO_EVENT_SELECTOR_URING_RWF_NOWAIT
+			else if (S_ISFIFO(stat.st_mode)) {
+				state->kind = IO_EVENT_SELECTOR_URING_DESCRIPTOR_PIPE;
+			}
+#endif
+		}
+	}
+	
+	if (state->kind == IO_EVENT_SELECTOR_URING_DESCRIPTOR_OTHER) return NULL;
+	
+	return state;
+}
+
+// Forget everything known about the descriptor, as it may be reused for a different kind of file.
+static
+void IO_Event_Selector_URing_Descriptor_close(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	if (descriptor < 0 || (size_t)descriptor >= selector->descriptors.limit) return;
+	
+	struct IO_Event_Selector_URing_Descriptor *state = selector->descriptors.base[descriptor];
+	if (state) IO_Event_Selector_URing_Descriptor_initialize(state);
+}
+
+// Whether an optimistic attempt should be made, or the operation should go straight to the ring because recent attempts kept failing.
+static inline
+int IO_Event_Selector_URing_Attempts_try(struct IO_Event_Selector_URing_Attempts *attempts)
+{
+	if (attempts->skip) {
+		attempts->skip -= 1;
+		return 0;
+	}
+	
+	return 1;
+}
+
+// Record the result of an optimistic attempt. Returns the result, or -EAGAIN if the operation should be submitted to the ring.
+static
+int IO_Event_Selector_URing_Attempts_record(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Attempts *attempts, ssize_t result)
+{
+	if (result < 0 && (IO_Event_try_again(-result) || result == -EINTR)) {
+		selector->optimistic_misses += 1;
+		
+		if (attempts->misses < URING_OPTIMISTIC_MISSES + URING_OPTIMISTIC_BACKOFF) {
+			attempts->misses += 1;
+		}
+		
+		if (attempts->misses >= URING_OPTIMISTIC_MISSES) {
+			attempts->skip = 1u << (attempts->misses - URING_OPTIMISTIC_MISSES);
+		}
+		
+		return -EAGAIN;
+	}
+	
+	selector->optimistic_hits += 1;
+	attempts->misses = 0;
+	
+	return (int)result;
+}
+
+// Whether the optimistic attempt failed because it doesn't apply to the descriptor, in which case the operation should be submitted to the ring without reporting the error.
+static inline
+int IO_Event_Selector_URing_Descriptor_unsupported(struct IO_Event_Selector_URing_Descriptor *state, ssize_t result)
+{
+	if (result == -ENOTSOCK) {
+		// The descriptor was reused by something other than a socket without going through `io_close` (which older versions of Ruby don't call), so it must be classified again:
+		IO_Event_Selector_URing_Descriptor_initialize(state);
+		return 1;
+	}
+	
+	if (result == -EOPNOTSUPP) {
+		// Older kernels don't support `RWF_NOWAIT` on pipes, and some sockets don't support `MSG_DONTWAIT`:
+		state->kind = IO_EVENT_SELECTOR_URING_DESCRIPTOR_OTHER;
+		return 1;
+	}
+	
+	return 0;
+}
+
+// Try to read directly from a socket or pipe without blocking. Returns -EAGAIN if the read should be submitted to the ring instead.
+static
+int io_read_optimistic(struct IO_Event_Selector_URing *selector, int descriptor, char *buffer, size_t length)
+{
+	struct IO_Event_Selector_URing_Descriptor *state = IO_Event_Selector_URing_Descriptor_optimistic(selector, descriptor);
+	if (!state || !IO_Event_Selector_URing_Attempts_try(&state->read)) return -EAGAIN;
+	
+	ssize_t result;
+	
+	if (state->kind == IO_EVENT_SELECTOR_URING_DESCRIPTOR_SOCKET) {
+		result = recv(descriptor, buffer, length, MSG_DONTWAIT);
+	} else {
+#ifdef IO_EVENT_SELECTOR_URING_RWF_NOWAIT
+		struct iovec iovec = {.iov_base = buffer, .iov_len = length};
+		result = preadv2(descriptor, &iovec, 1, -1, RWF_NOWAIT);
+#else
+		return -EAGAIN;
+#endif
+	}
+	
+	if (result < 0) {
+		result = -errno;
+		
+		if (IO_Event_Selector_URing_Descriptor_unsupported(state, result)) return -EAGAIN;
+	}
+	
+	return IO_Event_Selector_URing_Attempts_record(selector, &state->read, result);
+}
+
+// Try to write directly to a socket or pipe without blocking. Returns -EAGAIN if the write should be submitted to the ring instead.
+static
+int io_write_optimistic(struct IO_Event_Selector_URing *selector, int descriptor, const char *buffer, size_t length)
+{
+	struct IO_Event_Selector_URing_Descriptor *state = IO_Event_Selector_URing_Descriptor_optimistic(selector, descriptor);
+	if (!state || !IO_Event_Selector_URing_Attempts_try(&state->write)) return -EAGAIN;
+	
+	ssize_t result;
+	
+	if (state->kind == IO_EVENT_SELECTOR_URING_DESCRIPTOR_SOCKET) {
+		result = send(descriptor, buffer, length, MSG_DONTWAIT);
+	} else {
+#ifdef IO_EVENT_SELECTOR_URING_RWF_NOWAIT
+		struct iovec iovec = {.iov_base = (void*)buffer, .iov_len = length};
+		result = pwritev2(descriptor, &iovec, 1, -1, RWF_NOWAIT);
+#else
+		return -EAGAIN;
+#endif
+	}
+	
+	if (result < 0) {
+		result = -errno;
+		
+		if (IO_Event_Selector_URing_Descriptor_unsupported(state, result)) return -EAGAIN;
+	}
+	
+	return IO_Event_Selector_URing_Attempts_record(selector, &state->write, result);
+}
+
+VALUE IO_Event_Selector_URing_optimistic_io(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return selector->optimistic_io ? Qtrue : Qfalse;
+}
+
+// Enable or disable optimistic reads and writes. When enabled, `io_read` and `io_write` on sockets and pipes first try the operation directly without blocking, which avoids a round trip through the ring when data (or buffer space) is already available. Descriptors on which attempts keep failing back off and go straight to the ring.
+VALUE IO_Event_Selector_URing_optimistic_io_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	selector->optimistic_io = RTEST(value);
+	
+	return value;
+}
+
+#pragma mark - IO#read
+
+struct io_read_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Waiting *waiting;
+	int descriptor;
+	off_t offset;
+	char *buffer;
+	size_t length;
+	struct __kernel_timespec *deadline;
+};
+
+static VALUE
+io_read_submit(VALUE _arguments)
+{
+	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	if (DEBUG) fprintf(stderr, "io_read_submit:io_uring_prep_read(waiting=%p, completion=%p, descriptor=%d, buffer=%p, length=%ld)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->buffer, arguments->length);
+	
+	struct io_uring_sqe *sqe = io_get_sqe_linked(selector, arguments->deadline);
+	io_uring_prep_read(sqe, arguments->descriptor, arguments->buffer, arguments->length, arguments->offset);
+	io_set_file(selector, sqe, arguments->descriptor);
+	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_link_deadline(selector, sqe, arguments->deadline);
+	io_uring_submit_pending(selector);
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return RB_INT2NUM(io_deadline_result(arguments->deadline, arguments->waiting->result));
+}
+
+static VALUE
+io_read_ensure(VALUE _arguments)
+{
+	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	// If the operation is still in progress, cancel it:
+	if (arguments->waiting->completion) {
+		arguments->selector->backend.statistics.cancellations += 1;
+		if (DEBUG) fprintf(stderr, "io_read_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
+		struct io_uring_sqe *sqe = io_get_sqe(selector);
+		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
+		io_uring_sqe_set_data(sqe, NULL);
+		io_uring_submit_now(selector);
+	}
+	
+	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
+	
+	return Qnil;
+}
+
+static int
+io_read(struct IO_Event_Selector_URing *selector, VALUE fiber, int descriptor, char *buffer, size_t length, off_t offset, struct __kernel_timespec *deadline)
+{
+	struct IO_Event_Selector_URing_Waiting waiting = {
+		.fiber = fiber,
+	};
+	
+	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	
+	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	
+	struct io_read_arguments io_read_arguments = {
+		.selector = selector,
+		.waiting = &waiting,
+		.descriptor = descriptor,
+		.offset = offset,
+		.buffer = buffer,
+		.length = length,
+		.deadline = deadline,
+	};
+	
+	return RB_NUM2INT(
+		rb_ensure(io_read_submit, (VALUE)&io_read_arguments, io_read_ensure, (VALUE)&io_read_arguments)
+	);
+}
+
+static
+VALUE io_read_buffer(VALUE self, struct IO_Event_Selector_URing *selector, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset, struct __kernel_timespec *deadline) {
+	void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	
+	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	off_t from = io_seekable(descriptor);
+	
+	size_t maximum_size = size - offset;
+	
+	// Are we performing a non-blocking read?
+	if (!length) {
+		// If the (maximum) length is zero, that indicates we just want to read whatever is available without blocking.
+		// If we schedule this read into the URing, it will block until data is available, rather than returning immediately.
+		int state = IO_Event_Selector_nonblock_set(descriptor);
+		
+		int result = read(descriptor, (char*)base+offset, maximum_size);
+		int error = errno;
+		
+		IO_Event_Selector_nonblock_restore(descriptor, state);
+		return rb_fiber_scheduler_io_result(result, error);
+	}
+	
+	while (maximum_size) {
+		int result = io_read_optimistic(selector, descriptor, (char*)base+offset, maximum_size);
+		
+		if (result == -EAGAIN) {
+			result = io_read(selector, fiber, descriptor, (char*)base+offset, maximum_size, from, deadline);
+		}
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else if (length > 0 && IO_Event_try_again(-result)) {
+			if (io_wait(self, selector, fiber, io, RB_INT2NUM(IO_EVENT_READABLE), deadline) == Qfalse && deadline) {
+				// The deadline expired while waiting, so return the partial read (if any):
+				if (total > 0) break;
+				
+				return rb_fiber_scheduler_io_result(-1, ETIMEDOUT);
+			}
+		} else if (result == -ETIMEDOUT && total > 0) {
+			// The deadline expired after a partial transfer, so return what we have:
+			break;
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+VALUE IO_Event_Selector_URing_io_read(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return io_read_buffer(self, selector, fiber, io, buffer, _length, _offset, NULL);
+}
+
+// `io_read(fiber, io, buffer, length, offset = 0, timeout = nil)`: If a timeout is given, it is enforced by the kernel using a linked timeout. If it expires before any data is read, the operation fails with `ETIMEDOUT`, otherwise the partial result is returned.
+static VALUE IO_Event_Selector_URing_io_read_compatible(int argc, VALUE *argv, VALUE self)
+{
+	rb_check_arity(argc, 4, 6);
+	
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	VALUE _offset = SIZET2NUM(0);
+	struct __kernel_timespec storage;
+	struct __kernel_timespec *deadline = NULL;
+	
+	if (argc >= 5) {
+		_offset = argv[4];
+	}
+	
+	if (argc == 6) {
+		deadline = make_deadline(argv[5], &storage);
+	}
+	
+	return io_read_buffer(self, selector, argv[0], argv[1], argv[2], argv[3], _offset, deadline);
+}
+
+VALUE IO_Event_Selector_URing_io_pread(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	off_t from = NUM2OFFT(_from);
+	
+	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	
+	size_t maximum_size = size - offset;
+	while (maximum_size) {
+		int result = io_read(selector, fiber, descriptor, (char*)base+offset, maximum_size, from, NULL);
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			from += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else if (length > 0 && IO_Event_try_again(-result)) {
+			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_READABLE));
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+
+#pragma mark - IO#read (provided buffers)
+
+// Register a ring of `count` provided buffers of `size` bytes each, for use by `io_read_provided`.
+VALUE IO_Event_Selector_URing_provide_buffers(VALUE self, VALUE _count, VALUE _size) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	unsigned count = NUM2UINT(_count);
+	unsigned size = NUM2UINT(_size);
+	
+	if (selector->buffers.ring) {
+		rb_raise(rb_eRuntimeError, "Buffers have already been provided!");
+	}
+	
+	// The kernel requires a power of two number of entries:
+	if (count == 0 || count > URING_BUFFER_COUNT_MAXIMUM || (count & (count - 1)) != 0) {
+		rb_raise(rb_eArgError, "Buffer count must be a power of two between 1 and %d!", URING_BUFFER_COUNT_MAXIMUM);
+	}
+	
+	if (size == 0) {
+		rb_raise(rb_eArgError, "Buffer size must be positive!");
+	}
+	
+	char *base = xmalloc2(count, size);
+	
+	int result = 0;
+	struct io_uring_buf_ring *ring = io_uring_setup_buf_ring(&selector->ring, count, URING_BUFFER_GROUP, 0, &result);
+	
+	if (ring == NULL) {
+		xfree(base);
+		rb_syserr_fail(-result, "IO_Event_Selector_URing_provide_buffers:io_uring_setup_buf_ring");
+	}
+	
+	selector->buffers.ring = ring;
+	selector->buffers.base = base;
+	selector->buffers.count = count;
+	selector->buffers.size = size;
+	
+	for (unsigned index = 0; index < count; index += 1) {
+		io_uring_buf_ring_add(ring, base + (size_t)index * size, size, index, io_uring_buf_ring_mask(count), index);
+	}
+	
+	io_uring_buf_ring_advance(ring, count);
+	
+	return self;
+}
+
+static VALUE
+io_read_provided_submit(VALUE _arguments)
+{
+	struct io_read_arguments *arguments = (struct io_read_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	if (DEBUG) fprintf(stderr, "io_read_provided_submit:io_uring_prep_read(waiting=%p, completion=%p, descriptor=%d, length=%ld)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->length);
+	
+	// The buffer is selected by the kernel from the provided buffer group when data is available:
+	struct io_uring_sqe *sqe = io_get_sqe(selector);
+	io_uring_prep_read(sqe, arguments->descriptor, NULL, arguments->length, arguments->offset);
+	io_set_file(selector, sqe, arguments->descriptor);
+	sqe->flags |= IOSQE_BUFFER_SELECT;
+	sqe->buf_group = URING_BUFFER_GROUP;
+	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_uring_submit_pending(selector);
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return RB_INT2NUM(arguments->waiting->result);
+}
+
+struct io_read_provided_arguments {
+	struct IO_Event_Selector_URing *selector;
+	unsigned short index;
+	char *base;
+	size_t length;
+	VALUE buffer;
+};
+
+static VALUE
+io_read_provided_yield(VALUE _arguments)
+{
+	struct io_read_provided_arguments *arguments = (struct io_read_provided_arguments *)_arguments;
+	
+	if (rb_block_given_p()) {
+		// Expose the selected buffer directly. The view is only valid for the duration of the block:
+		arguments->buffer = rb_io_buffer_new(arguments->base, arguments->length, RB_IO_BUFFER_EXTERNAL | RB_IO_BUFFER_READONLY);
+		
+		return rb_yield(arguments->buffer);
+	} else {
+		// Copy the data out, so that the selected buffer can be recycled immediately:
+		VALUE buffer = rb_io_buffer_new(NULL, arguments->length, RB_IO_BUFFER_INTERNAL);
+		
+		void *base;
+		size_t size;
+		rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+		memcpy(base, arguments->base, arguments->length);
+		
+		return buffer;
+	}
+}
+
+static VALUE
+io_read_provided_release(VALUE _arguments)
+{
+	struct io_read_provided_arguments *arguments = (struct io_read_provided_arguments *)_arguments;
+	
+	if (arguments->buffer != Qnil) {
+		rb_io_buffer_free(arguments->buffer);
+	}
+	
+	IO_Event_Selector_URing_buffers_recycle(arguments->selector, arguments->index);
+	
+	return Qnil;
+}
+
+// Read from the given IO into a buffer selected by the kernel from the provided buffer ring (see `provide_buffers`). No memory is pinned while the read is pending.
+//
+// If a block is given, it is invoked with a read-only view of the selected buffer, which is recycled when the block returns, and the result of the block is returned. Otherwise, a copy of the data is returned. Returns `nil` at end of file.
+VALUE IO_Event_Selector_URing_io_read_provided(VALUE self, VALUE fiber, VALUE io) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	if (selector->buffers.ring == NULL) {
+		rb_raise(rb_eRuntimeError, "No buffers have been provided!");
+	}
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	off_t from = io_seekable(descriptor);
+	
+	while (true) {
+		struct IO_Event_Selector_URing_Waiting waiting = {
+			.fiber = fiber,
+		};
+		
+		RB_OBJ_WRITTEN(self, Qundef, fiber);
+		
+		IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+		
+		struct io_read_arguments io_read_arguments = {
+			.selector = selector,
+			.waiting = &waiting,
+			.descriptor = descriptor,
+			.offset = from,
+			.buffer = NULL,
+			.length = selector->buffers.size,
+		};
+		
+		int result = RB_NUM2INT(
+			rb_ensure(io_read_provided_submit, (VALUE)&io_read_arguments, io_read_ensure, (VALUE)&io_read_arguments)
+		);
+		
+		if (waiting.flags & IORING_CQE_F_BUFFER) {
+			unsigned short index = waiting.flags >> IORING_CQE_BUFFER_SHIFT;
+			
+			struct io_read_provided_arguments arguments = {
+				.selector = selector,
+				.index = index,
+				.base = selector->buffers.base + (size_t)index * selector->buffers.size,
+				.length = result > 0 ? result : 0,
+				.buffer = Qnil,
+			};
+			
+			if (result <= 0) {
+				IO_Event_Selector_URing_buffers_recycle(selector, index);
+			} else {
+				return rb_ensure(io_read_provided_yield, (VALUE)&arguments, io_read_provided_release, (VALUE)&arguments);
+			}
+		}
+		
+		if (result == 0) {
+			return Qnil;
+		} else if (result == -ENOBUFS) {
+			// Every provided buffer is in use, so wait until the descriptor is readable and read into a private buffer instead:
+			VALUE buffer = rb_io_buffer_new(NULL, selector->buffers.size, RB_IO_BUFFER_INTERNAL);
+			VALUE length = io_read_buffer(self, selector, fiber, io, buffer, SIZET2NUM(1), SIZET2NUM(0), NULL);
+			
+			ssize_t size = NUM2SSIZET(length);
+			
+			if (size < 0) {
+				rb_syserr_fail(-size, "IO_Event_Selector_URing_io_read_provided:io_read");
+			} else if (size == 0) {
+				return Qnil;
+			}
+			
+			rb_io_buffer_resize(buffer, size);
+			
+			return rb_block_given_p() ? rb_yield(buffer) : buffer;
+		} else if (IO_Event_try_again(-result)) {
+			io_wait(self, selector, fiber, io, RB_INT2NUM(IO_EVENT_READABLE), NULL);
+		} else if (result < 0) {
+			rb_syserr_fail(-result, "IO_Event_Selector_URing_io_read_provided:io_uring_prep_read");
+		}
+	}
+}
+
+#endif
+
+#pragma mark - IO#write
+
+struct io_write_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Waiting *waiting;
+	int descriptor;
+	off_t offset;
+	char *buffer;
+	size_t length;
+	struct __kernel_timespec *deadline;
+	int zero_copy;
+};
+
+static VALUE
+io_write_submit(VALUE _argument)
+{
+	struct io_write_arguments *arguments = (struct io_write_arguments*)_argument;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	if (DEBUG) fprintf(stderr, "io_write_submit:io_uring_prep_write(waiting=%p, completion=%p, descriptor=%d, buffer=%p, length=%ld)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->buffer, arguments->length);
+	
+	struct io_uring_sqe *sqe = io_get_sqe_linked(selector, arguments->deadline);
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+	if (arguments->zero_copy) {
+		// The kernel posts the result, followed by a notification once it no longer references the buffer. The operation is only complete (and the fiber resumed) after the notification, so the buffer remains valid until then. If the fiber is interrupted, `io_write_ensure` still waits for the notification:
+		io_uring_prep_send_zc(sqe, arguments->descriptor, arguments->buffer, arguments->length, 0, 0);
+	} else
+#endif
+	io_uring_prep_write(sqe, arguments->descriptor, arguments->buffer, arguments->length, arguments->offset);
+	io_set_file(selector, sqe, arguments->descriptor);
+	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_link_deadline(selector, sqe, arguments->deadline);
+	io_uring_submit_pending(selector);
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return RB_INT2NUM(io_deadline_result(arguments->deadline, arguments->waiting->result));
+}
+
+static VALUE
+io_write_ensure(VALUE _argument)
+{
+	struct io_write_arguments *arguments = (struct io_write_arguments*)_argument;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	// If the operation is still in progress, cancel it:
+	if (arguments->waiting->completion) {
+		arguments->selector->backend.statistics.cancellations += 1;
+		if (DEBUG) fprintf(stderr, "io_write_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
+		struct io_uring_sqe *sqe = io_get_sqe(selector);
+		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
+		io_uring_sqe_set_data(sqe, NULL);
+		io_uring_submit_now(selector);
+		
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+		// The kernel references the buffer of a zero-copy send until it posts the notification, even if the send was cancelled. The buffer belongs to the caller (e.g. a string passed to `IO#write`), so we can't return until then:
+		if (arguments->zero_copy) {
+			io_completion_wait(selector, arguments->waiting);
+		}
+#endif
+	}
+	
+	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
+	
+	return Qnil;
+}
+
+static int
+io_write(struct IO_Event_Selector_URing *selector, VALUE fiber, int descriptor, char *buffer, size_t length, off_t offset, struct __kernel_timespec *deadline, int zero_copy)
+{
+	struct IO_Event_Selector_URing_Waiting waiting = {
+		.fiber = fiber,
+	};
+	
+	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	
+	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	
+	struct io_write_arguments arguments = {
+		.selector = selector,
+		.waiting = &waiting,
+		.descriptor = descriptor,
+		.offset = offset,
+		.buffer = buffer,
+		.length = length,
+		.deadline = deadline,
+		.zero_copy = zero_copy,
+	};
+	
+	return RB_NUM2INT(
+		rb_ensure(io_write_submit, (VALUE)&arguments, io_write_ensure, (VALUE)&arguments)
+	);
+}
+
+static
+VALUE io_write_buffer(VALUE self, struct IO_Event_Selector_URing *selector, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset, struct __kernel_timespec *deadline) {
+	const void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_reading(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	
+	if (length > size) {
+		rb_raise(rb_eRuntimeError, "Length exceeds size of buffer!");
+	}
+
+	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	off_t from = io_seekable(descriptor);
+	
+	size_t maximum_size = size - offset;
+	
+	int zero_copy = 0;
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+	zero_copy = selector->zero_copy_threshold && maximum_size >= selector->zero_copy_threshold;
+#endif
+	
+	while (maximum_size) {
+		// Zero-copy sends are only worthwhile for large writes, which are unlikely to fit in the socket buffer anyway:
+		int result = zero_copy ? -EAGAIN : io_write_optimistic(selector, descriptor, (const char*)base+offset, maximum_size);
+		
+		if (result == -EAGAIN) {
+			result = io_write(selector, fiber, descriptor, (char*)base+offset, maximum_size, from, deadline, zero_copy);
+		}
+		
+		if (zero_copy && (result == -ENOTSOCK || result == -EOPNOTSUPP)) {
+			// Zero-copy sends are only supported by some sockets, so fall back to a regular write:
+			zero_copy = 0;
+			continue;
+		}
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else if (length > 0 && IO_Event_try_again(-result)) {
+			if (io_wait(self, selector, fiber, io, RB_INT2NUM(IO_EVENT_WRITABLE), deadline) == Qfalse && deadline) {
+				// The deadline expired while waiting, so return the partial write (if any):
+				if (total > 0) break;
+				
+				return rb_fiber_scheduler_io_result(-1, ETIMEDOUT);
+			}
+		} else if (result == -ETIMEDOUT && total > 0) {
+			// The deadline expired after a partial transfer, so return what we have:
+			break;
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+VALUE IO_Event_Selector_URing_io_write(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return io_write_buffer(self, selector, fiber, io, buffer, _length, _offset, NULL);
+}
+
+// `io_write(fiber, io, buffer, length, offset = 0, timeout = nil)`: If a timeout is given, it is enforced by the kernel using a linked timeout. If it expires before any data is written, the operation fails with `ETIMEDOUT`, otherwise the partial result is returned.
+static VALUE IO_Event_Selector_URing_io_write_compatible(int argc, VALUE *argv, VALUE self)
+{
+	rb_check_arity(argc, 4, 6);
+	
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	VALUE _offset = SIZET2NUM(0);
+	struct __kernel_timespec storage;
+	struct __kernel_timespec *deadline = NULL;
+	
+	if (argc >= 5) {
+		_offset = argv[4];
+	}
+	
+	if (argc == 6) {
+		deadline = make_deadline(argv[5], &storage);
+	}
+	
+	return io_write_buffer(self, selector, argv[0], argv[1], argv[2], argv[3], _offset, deadline);
+}
+
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+VALUE IO_Event_Selector_URing_zero_copy_threshold(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	if (selector->zero_copy_threshold) {
+		return SIZET2NUM(selector->zero_copy_threshold);
+	} else {
+		return Qnil;
+	}
+}
+
+// Writes to sockets of at least this many bytes use zero-copy sends, avoiding a copy into the socket buffer at the cost of waiting until the kernel releases the buffer (typically when the data is acknowledged). Set to `nil` to disable. Raises `NotImplementedError` if the kernel does not support zero-copy sends.
+VALUE IO_Event_Selector_URing_zero_copy_threshold_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	size_t threshold = NIL_P(value) ? 0 : NUM2SIZET(value);
+	
+	if (threshold) {
+		struct io_uring_probe *probe = io_uring_get_probe_ring(&selector->ring);
+		int supported = probe && io_uring_opcode_supported(probe, IORING_OP_SEND_ZC);
+		if (probe) io_uring_free_probe(probe);
+		
+		if (!supported) {
+			rb_raise(rb_eNotImpError, "Zero-copy sends are not supported by this kernel!");
+		}
+	}
+	
+	selector->zero_copy_threshold = threshold;
+	
+	return value;
+}
+#endif
+
+VALUE IO_Event_Selector_URing_io_pwrite(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	const void *base;
+	size_t size;
+	rb_io_buffer_get_bytes_for_reading(buffer, &base, &size);
+	
+	size_t length = NUM2SIZET(_length);
+	size_t offset = NUM2SIZET(_offset);
+	size_t total = 0;
+	off_t from = NUM2OFFT(_from);
+	
+	if (length > size) {
+		rb_raise(rb_eRuntimeError, "Length exceeds size of buffer!");
+	}
+
+	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
+	if (offset > size) {
+		return rb_fiber_scheduler_io_result(-1, EINVAL);
+	} else if (offset == size) {
+		return rb_fiber_scheduler_io_result(0, 0);
+	}
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	
+	size_t maximum_size = size - offset;
+	while (maximum_size) {
+		int result = io_write(selector, fiber, descriptor, (char*)base+offset, maximum_size, from, NULL, 0);
+		
+		if (result > 0) {
+			total += result;
+			offset += result;
+			from += result;
+			if ((size_t)result >= length) break;
+			length -= result;
+		} else if (result == 0) {
+			break;
+		} else if (length > 0 && IO_Event_try_again(-result)) {
+			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_WRITABLE));
+		} else {
+			return rb_fiber_scheduler_io_result(-1, -result);
+		}
+		
+		maximum_size = size - offset;
+	}
+	
+	return rb_fiber_scheduler_io_result(total, 0);
+}
+
+#pragma mark - IO#readv/IO#writev
+
+struct io_vector_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Waiting *waiting;
+	int descriptor;
+	off_t offset;
+	const struct iovec *iovecs;
+	int count;
+	
+	// Whether to write the iovecs to the descriptor, otherwise read into them.
+	int writing;
+};
+
+static VALUE
+io_vector_submit(VALUE _arguments)
+{
+	struct io_vector_arguments *arguments = (struct io_vector_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	if (DEBUG) fprintf(stderr, "io_vector_submit(waiting=%p, completion=%p, descriptor=%d, count=%d, writing=%d)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->count, arguments->writing);
+	
+	struct io_uring_sqe *sqe = io_get_sqe(selector);
+	if (arguments->writing) {
+		io_uring_prep_writev(sqe, arguments->descriptor, arguments->iovecs, arguments->count, arguments->offset);
+	} else {
+		io_uring_prep_readv(sqe, arguments->descriptor, arguments->iovecs, arguments->count, arguments->offset);
+	}
+	io_set_file(selector, sqe, arguments->descriptor);
+	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_uring_submit_pending(selector);
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return RB_INT2NUM(arguments->waiting->result);
+}
+
+static VALUE
+io_vector_ensure(VALUE _arguments)
+{
+	struct io_vector_arguments *arguments = (struct io_vector_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	// If the operation is still in progress, cancel it:
+	if (arguments->waiting->completion) {
+		arguments->selector->backend.statistics.cancellations += 1;
+		if (DEBUG) fprintf(stderr, "io_vector_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
+		struct io_uring_sqe *sqe = io_get_sqe(selector);
+		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
+		io_uring_sqe_set_data(sqe, NULL);
+		io_uring_submit_now(selector);
+	}
+	
+	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
+	
+	return Qnil;
+}
+
+static int
+io_vector(struct IO_Event_Selector_URing *selector, VALUE fiber, int descriptor, const struct iovec *iovecs, int count, off_t offset, int writing)
+{
+	struct IO_Event_Selector_URing_Waiting waiting = {
+		.fiber = fiber,
+	};
+	
+	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	
+	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	
+	struct io_vector_arguments arguments = {
+		.selector = selector,
+		.waiting = &waiting,
+		.descriptor = descriptor,
+		.offset = offset,
+		.iovecs = iovecs,
+		.count = count,
+		.writing = writing,
+	};
+	
+	return RB_NUM2INT(
+		rb_ensure(io_vector_submit, (VALUE)&arguments, io_vector_ensure, (VALUE)&arguments)
+	);
+}
+
+// Read into the given buffers, in order, using a single `readv` operation. Returns the number of bytes read, which is zero at end of file.
+VALUE IO_Event_Selector_URing_io_readv(VALUE self, VALUE fiber, VALUE io, VALUE buffers) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	int count = IO_Event_Selector_iovec_count(buffers);
+	
+	VALUE storage = 0;
+	struct iovec *iovecs = ALLOCV_N(struct iovec, storage, count);
+	IO_Event_Selector_iovec_fill(buffers, iovecs, count, 1);
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	off_t from = io_seekable(descriptor);
+	
+	int result = 0;
+	
+	while (count) {
+		result = io_vector(selector, fiber, descriptor, iovecs, count, from, 0);
+		
+		if (IO_Event_try_again(-result)) {
+			io_wait(self, selector, fiber, io, RB_INT2NUM(IO_EVENT_READABLE), NULL);
+		} else {
+			break;
+		}
+	}
+	
+	ALLOCV_END(storage);
+	
+	if (result < 0) {
+		return rb_fiber_scheduler_io_result(-1, -result);
+	} else {
+		return rb_fiber_scheduler_io_result(result, 0);
+	}
+}
+
+// Write all of the given buffers, in order, using `writev` operations. Returns the total number of bytes written.
+VALUE IO_Event_Selector_URing_io_writev(VALUE self, VALUE fiber, VALUE io, VALUE buffers) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	int count = IO_Event_Selector_iovec_count(buffers);
+	
+	VALUE storage = 0;
+	struct iovec *iovecs = ALLOCV_N(struct iovec, storage, count);
+	IO_Event_Selector_iovec_fill(buffers, iovecs, count, 0);
+	
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	off_t from = io_seekable(descriptor);
+	
+	struct iovec *remaining = iovecs;
+	size_t total = 0;
+	int error = 0;
+	
+	while (count) {
+		int result = io_vector(selector, fiber, descriptor, remaining, count, from, 1);
+		
+		if (result > 0) {
+			total += result;
+			IO_Event_Selector_iovec_advance(&remaining, &count, result);
+		} else if (result == 0) {
+			break;
+		} else if (IO_Event_try_again(-result)) {
+			io_wait(self, selector, fiber, io, RB_INT2NUM(IO_EVENT_WRITABLE), NULL);
+		} else {
+			error = -result;
+			break;
+		}
+	}
+	
+	ALLOCV_END(storage);
+	
+	if (error) {
+		return rb_fiber_scheduler_io_result(-1, error);
+	} else {
+		return rb_fiber_scheduler_io_result(total, 0);
+	}
+}
+
+#endif
+
+#pragma mark - File Operations
+
+struct io_file_arguments;
+typedef void (*io_file_prepare_t)(struct io_uring_sqe *sqe, struct io_file_arguments *arguments);
+
+struct io_file_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Waiting *waiting;
+	
+	// Prepares the submission queue entry for the specific operation:
+	io_file_prepare_t prepare;
+	
+	int descriptor;
+	const char *path;
+	int flags;
+	mode_t mode;
+	off_t offset;
+	off_t length;
+	struct statx *statx;
+	
+	// The output descriptor for splicing:
+	int output;
+	
+	// Whether the result is a new descriptor, which must be closed if the operation completes after it was cancelled:
+	int opens;
+};
+
+static VALUE
+io_file_submit(VALUE _arguments)
+{
+	struct io_file_arguments *arguments = (struct io_file_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	if (DEBUG) fprintf(stderr, "io_file_submit(waiting=%p, completion=%p, descriptor=%d, path=%s)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->path ? arguments->path : "(null)");
+	
+	struct io_uring_sqe *sqe = io_get_sqe(selector);
+	arguments->prepare(sqe, arguments);
+	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_uring_submit_pending(selector);
+	
+	IO_Event_Selector_loop_yield(&selector->backend);
+	
+	return RB_INT2NUM(arguments->waiting->result);
+}
+
+static VALUE
+io_file_ensure(VALUE _arguments)
+{
+	struct io_file_arguments *arguments = (struct io_file_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	// If the operation is still in progress, cancel it:
+	if (arguments->waiting->completion) {
+		arguments->selector->backend.statistics.cancellations += 1;
+		if (DEBUG) fprintf(stderr, "io_file_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
+		struct io_uring_sqe *sqe = io_get_sqe(selector);
+		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
+		io_uring_sqe_set_data(sqe, NULL);
+		io_uring_submit_now(selector);
+		
+		// File operations run in worker threads and can't be cancelled once they have started, and they write into buffers on the fiber stack (e.g. `statx`), so we must wait for them to complete:
+		arguments->waiting->result = -ECANCELED;
+		io_completion_wait(selector, arguments->waiting);
+		
+		if (arguments->opens && arguments->waiting->result >= 0) {
+			close(arguments->waiting->result);
+		}
+	}
+	
+	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
+	
+	return Qnil;
+}
+
+static int
+io_file(struct IO_Event_Selector_URing *selector, VALUE fiber, struct io_file_arguments *arguments)
+{
+	struct IO_Event_Selector_URing_Waiting waiting = {
+		.fiber = fiber,
+	};
+	
+	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	
+	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	
+	arguments->selector = selector;
+	arguments->waiting = &waiting;
+	
+	return RB_NUM2INT(
+		rb_ensure(io_file_submit, (VALUE)arguments, io_file_ensure, (VALUE)arguments)
 	);
 }
 
-VALUE IO_Event_Selector_URing_io_read(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset) {
+static void
+io_open_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
+{
+	io_uring_prep_openat(sqe, AT_FDCWD, arguments->path, arguments->flags, arguments->mode);
+}
+
+// Open the file at the given path, like `IO.sysopen`. The descriptor is always opened with `O_CLOEXEC`.
+//
+// Returns the file descriptor as an Integer, or a negated errno.
+VALUE IO_Event_Selector_URing_io_open(VALUE self, VALUE fiber, VALUE path, VALUE flags, VALUE mode) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	void *base;
-	size_t size;
-	rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+	path = rb_get_path(path);
 	
-	size_t length = NUM2SIZET(_length);
-	size_t offset = NUM2SIZET(_offset);
-	size_t total = 0;
+	struct io_file_arguments arguments = {
+		.prepare = io_open_prepare,
+		.opens = 1,
+		.descriptor = -1,
+		.path = StringValueCStr(path),
+		.flags = NUM2INT(flags) | O_CLOEXEC,
+		.mode = NUM2UINT(mode),
+	};
 	
-	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
-	if (offset > size) {
-		return rb_fiber_scheduler_io_result(-1, EINVAL);
-	} else if (offset == size) {
-		return rb_fiber_scheduler_io_result(0, 0);
+	int result = io_file(selector, fiber, &arguments);
+	RB_GC_GUARD(path);
+	
+	if (result >= 0) {
+		rb_update_max_fd(result);
 	}
 	
-	int descriptor = IO_Event_Selector_io_descriptor(io);
-	off_t from = io_seekable(descriptor);
+	return RB_INT2NUM(result);
+}
+
+static void
+io_stat_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
+{
+	io_uring_prep_statx(sqe, AT_FDCWD, arguments->path, 0, STATX_BASIC_STATS, arguments->statx);
+}
+
+static void
+io_stat_from_statx(struct stat *stat, const struct statx *statx)
+{
+	memset(stat, 0, sizeof(*stat));
+	
+	stat->st_dev = makedev(statx->stx_dev_major, statx->stx_dev_minor);
+	stat->st_ino = statx->stx_ino;
+	stat->st_mode = statx->stx_mode;
+	stat->st_nlink = statx->stx_nlink;
+	stat->st_uid = statx->stx_uid;
+	stat->st_gid = statx->stx_gid;
+	stat->st_rdev = makedev(statx->stx_rdev_major, statx->stx_rdev_minor);
+	stat->st_size = statx->stx_size;
+	stat->st_blksize = statx->stx_blksize;
+	stat->st_blocks = statx->stx_blocks;
+	
+	stat->st_atim.tv_sec = statx->stx_atime.tv_sec;
+	stat->st_atim.tv_nsec = statx->stx_atime.tv_nsec;
+	stat->st_mtim.tv_sec = statx->stx_mtime.tv_sec;
+	stat->st_mtim.tv_nsec = statx->stx_mtime.tv_nsec;
+	stat->st_ctim.tv_sec = statx->stx_ctime.tv_sec;
+	stat->st_ctim.tv_nsec = statx->stx_ctime.tv_nsec;
+}
+
+// Get the status of the file at the given path, following symbolic links, like `File.stat`.
+//
+// Returns a `File::Stat`, or a negated errno.
+VALUE IO_Event_Selector_URing_io_stat(VALUE self, VALUE fiber, VALUE path) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	size_t maximum_size = size - offset;
+	path = rb_get_path(path);
 	
-	// Are we performing a non-blocking read?
-	if (!length) {
-		// If the (maximum) length is zero, that indicates we just want to read whatever is available without blocking.
-		// If we schedule this read into the URing, it will block until data is available, rather than returning immediately.
-		int state = IO_Event_Selector_nonblock_set(descriptor);
-		
-		int result = read(descriptor, (char*)base+offset, maximum_size);
-		int error = errno;
-		
-		IO_Event_Selector_nonblock_restore(descriptor, state);
-		return rb_fiber_scheduler_io_result(result, error);
-	}
+	struct statx statx;
 	
-	while (maximum_size) {
-		int result = io_read(selector, fiber, descriptor, (char*)base+offset, maximum_size, from);
-		
-		if (result > 0) {
-			total += result;
-			offset += result;
-			if ((size_t)result >= length) break;
-			length -= result;
-		} else if (result == 0) {
-			break;
-		} else if (length > 0 && IO_Event_try_again(-result)) {
-			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_READABLE));
-		} else {
-			return rb_fiber_scheduler_io_result(-1, -result);
-		}
-		
-		maximum_size = size - offset;
+	struct io_file_arguments arguments = {
+		.prepare = io_stat_prepare,
+		.descriptor = -1,
+		.path = StringValueCStr(path),
+		.statx = &statx,
+	};
+	
+	int result = io_file(selector, fiber, &arguments);
+	RB_GC_GUARD(path);
+	
+	if (result < 0) {
+		return RB_INT2NUM(result);
 	}
 	
-	return rb_fiber_scheduler_io_result(total, 0);
+	struct stat stat;
+	io_stat_from_statx(&stat, &statx);
+	
+	return rb_stat_new(&stat);
 }
 
-static VALUE IO_Event_Selector_URing_io_read_compatible(int argc, VALUE *argv, VALUE self)
+static void
+io_fsync_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
 {
-	rb_check_arity(argc, 4, 5);
+	io_uring_prep_fsync(sqe, arguments->descriptor, arguments->flags);
+	io_set_file(arguments->selector, sqe, arguments->descriptor);
+}
+
+// `io_fsync(fiber, io, data = false)`: Flush the file's data and metadata to the storage device. If `data` is true, only the metadata required to read the data back is flushed, like `fdatasync`.
+//
+// Returns 0, or a negated errno.
+VALUE IO_Event_Selector_URing_io_fsync(int argc, VALUE *argv, VALUE self) {
+	rb_check_arity(argc, 2, 3);
 	
-	VALUE _offset = SIZET2NUM(0);
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	if (argc == 5) {
-		_offset = argv[4];
-	}
+	struct io_file_arguments arguments = {
+		.prepare = io_fsync_prepare,
+		.descriptor = IO_Event_Selector_URing_io_descriptor(selector, argv[1]),
+		.flags = (argc == 3 && RTEST(argv[2])) ? IORING_FSYNC_DATASYNC : 0,
+	};
 	
-	return IO_Event_Selector_URing_io_read(self, argv[0], argv[1], argv[2], argv[3], _offset);
+	return RB_INT2NUM(io_file(selector, argv[0], &arguments));
 }
 
-VALUE IO_Event_Selector_URing_io_pread(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+static void
+io_fallocate_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
+{
+	io_uring_prep_fallocate(sqe, arguments->descriptor, arguments->mode, arguments->offset, arguments->length);
+	io_set_file(arguments->selector, sqe, arguments->descriptor);
+}
+
+// Allocate disk space for the given region of the file, extending it if required, like `posix_fallocate`.
+//
+// Returns 0, or a negated errno.
+VALUE IO_Event_Selector_URing_io_fallocate(VALUE self, VALUE fiber, VALUE io, VALUE offset, VALUE length) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	void *base;
-	size_t size;
-	rb_io_buffer_get_bytes_for_writing(buffer, &base, &size);
+	struct io_file_arguments arguments = {
+		.prepare = io_fallocate_prepare,
+		.descriptor = IO_Event_Selector_URing_io_descriptor(selector, io),
+		.mode = 0,
+		.offset = NUM2OFFT(offset),
+		.length = NUM2OFFT(length),
+	};
 	
-	size_t length = NUM2SIZET(_length);
-	size_t offset = NUM2SIZET(_offset);
-	size_t total = 0;
-	off_t from = NUM2OFFT(_from);
+	return RB_INT2NUM(io_file(selector, fiber, &arguments));
+}
+
+#ifdef HAVE_RUBY_IO_BUFFER_H
+
+#pragma mark - IO#splice
+
+// Splice from the input into the intermediate pipe. Only the input may use the fixed file table (given by the splice flags), since a stale slot for the pipe's descriptor would redirect the data to a different file:
+static void
+io_splice_input_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
+{
+	unsigned int flags = arguments->flags;
 	
-	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
-	if (offset > size) {
-		return rb_fiber_scheduler_io_result(-1, EINVAL);
-	} else if (offset == size) {
-		return rb_fiber_scheduler_io_result(0, 0);
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	if (IO_Event_Selector_URing_File_find(arguments->selector, arguments->descriptor)) {
+		flags |= SPLICE_F_FD_IN_FIXED;
 	}
+#endif
 	
-	int descriptor = IO_Event_Selector_io_descriptor(io);
+	io_uring_prep_splice(sqe, arguments->descriptor, -1, arguments->output, -1, arguments->length, flags);
+}
+
+// Splice from the intermediate pipe into the output. Only the output may use the fixed file table (given by the entry flags):
+static void
+io_splice_output_prepare(struct io_uring_sqe *sqe, struct io_file_arguments *arguments)
+{
+	io_uring_prep_splice(sqe, arguments->descriptor, -1, arguments->output, -1, arguments->length, arguments->flags);
+	io_set_file(arguments->selector, sqe, arguments->output);
+}
+
+// Splice up to `length` bytes from `input` to `output`, where one of them is the intermediate pipe. Returns the number of bytes spliced, or a negated errno.
+static int
+io_splice(struct IO_Event_Selector_URing *selector, VALUE fiber, io_file_prepare_t prepare, int input, int output, size_t length)
+{
+	struct io_file_arguments arguments = {
+		.prepare = prepare,
+		.descriptor = input,
+		.output = output,
+		.length = length,
+		.flags = SPLICE_F_MOVE,
+	};
 	
-	size_t maximum_size = size - offset;
-	while (maximum_size) {
-		int result = io_read(selector, fiber, descriptor, (char*)base+offset, maximum_size, from);
+	return io_file(selector, fiber, &arguments);
+}
+
+struct io_splice_arguments {
+	VALUE self;
+	struct IO_Event_Selector_URing *selector;
+	VALUE fiber;
+	VALUE to;
+	
+	int input;
+	int output;
+	size_t length;
+	
+	// The intermediate pipe, which allows splicing between any two descriptors:
+	int pipe[2];
+	
+	// Whether the pipe is the selector's splice pipe, rather than a temporary one:
+	int shared;
+	
+	// Whether the pipe may still contain data, e.g. because the operation was interrupted or failed while draining it:
+	int dirty;
+};
+
+static VALUE
+io_splice_loop(VALUE _arguments)
+{
+	struct io_splice_arguments *arguments = (struct io_splice_arguments *)_arguments;
+	struct IO_Event_Selector_URing *selector = arguments->selector;
+	
+	size_t total = 0;
+	
+	while (total < arguments->length) {
+		size_t chunk = arguments->length - total;
+		if (chunk > URING_SPLICE_CHUNK) chunk = URING_SPLICE_CHUNK;
 		
-		if (result > 0) {
-			total += result;
-			offset += result;
-			from += result;
-			if ((size_t)result >= length) break;
-			length -= result;
-		} else if (result == 0) {
+		// Move data from the input into the pipe:
+		arguments->dirty = 1;
+		int result = io_splice(selector, arguments->fiber, io_splice_input_prepare, arguments->input, arguments->pipe[1], chunk);
+		
+		if (result == 0) {
+			arguments->dirty = 0;
 			break;
-		} else if (length > 0 && IO_Event_try_again(-result)) {
-			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_READABLE));
-		} else {
+		} else if (result < 0) {
+			arguments->dirty = 0;
+			
+			// Report the data which was already transferred, the error will occur again on the next call:
+			if (total) break;
+			
 			return rb_fiber_scheduler_io_result(-1, -result);
 		}
 		
-		maximum_size = size - offset;
+		// Drain the pipe into the output:
+		size_t pending = result;
+		while (pending) {
+			result = io_splice(selector, arguments->fiber, io_splice_output_prepare, arguments->pipe[0], arguments->output, pending);
+			
+			if (result > 0) {
+				pending -= result;
+				total += result;
+			} else if (IO_Event_try_again(-result)) {
+				io_wait(arguments->self, selector, arguments->fiber, arguments->to, RB_INT2NUM(IO_EVENT_WRITABLE), NULL);
+			} else if (total) {
+				// The data left in the pipe is discarded, but the data which was already transferred is reported:
+				return rb_fiber_scheduler_io_result(total, 0);
+			} else {
+				return rb_fiber_scheduler_io_result(-1, result < 0 ? -result : EPIPE);
+			}
+		}
+		
+		arguments->dirty = 0;
 	}
 	
 	return rb_fiber_scheduler_io_result(total, 0);
 }
 
-#pragma mark - IO#write
-
-struct io_write_arguments {
-	struct IO_Event_Selector_URing *selector;
-	struct IO_Event_Selector_URing_Waiting *waiting;
-	int descriptor;
-	off_t offset;
-	char *buffer;
-	size_t length;
-};
-
 static VALUE
-io_write_submit(VALUE _argument)
+io_splice_ensure(VALUE _arguments)
 {
-	struct io_write_arguments *arguments = (struct io_write_arguments*)_argument;
+	struct io_splice_arguments *arguments = (struct io_splice_arguments *)_arguments;
 	struct IO_Event_Selector_URing *selector = arguments->selector;
 	
-	if (DEBUG) fprintf(stderr, "io_write_submit:io_uring_prep_write(waiting=%p, completion=%p, descriptor=%d, buffer=%p, length=%ld)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion, arguments->descriptor, arguments->buffer, arguments->length);
+	if (arguments->shared) {
+		selector->splice_busy = 0;
+		
+		// The pipe is kept for the next operation, unless the selector was closed in the meantime (which closes the pipe too):
+		if (!arguments->dirty || selector->splice_pipe[0] != arguments->pipe[0]) return Qnil;
+		
+		// Any data left in the pipe would be sent by the next operation, so it is discarded and created again when it is next used:
+		selector->splice_pipe[0] = selector->splice_pipe[1] = -1;
+	}
+	
+	close(arguments->pipe[0]);
+	close(arguments->pipe[1]);
+	
+	return Qnil;
+}
+
+// Transfer up to `length` bytes from the current position of `from` to `to` using `IORING_OP_SPLICE`, without copying the data through user space. The data moves through a pipe owned by the selector (or a temporary pipe, if another fiber is already using it), so any two descriptors which support splicing can be used, e.g. a file and a socket. Stops early at end of file.
+//
+// Returns the number of bytes transferred, or a negated errno if an error occurred before any data was transferred.
+VALUE IO_Event_Selector_URing_io_splice(VALUE self, VALUE fiber, VALUE from, VALUE to, VALUE _length) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	struct io_splice_arguments arguments = {
+		.self = self,
+		.selector = selector,
+		.fiber = fiber,
+		.to = to,
+		
+		.input = IO_Event_Selector_URing_io_descriptor(selector, from),
+		.output = IO_Event_Selector_URing_io_descriptor(selector, to),
+		.length = NUM2SIZET(_length),
+	};
+	
+	if (!selector->splice_busy) {
+		if (selector->splice_pipe[0] < 0 && pipe2(selector->splice_pipe, O_CLOEXEC) < 0) {
+			return rb_fiber_scheduler_io_result(-1, errno);
+		}
+		
+		arguments.pipe[0] = selector->splice_pipe[0];
+		arguments.pipe[1] = selector->splice_pipe[1];
+		arguments.shared = 1;
+		selector->splice_busy = 1;
+	} else if (pipe2(arguments.pipe, O_CLOEXEC) < 0) {
+		return rb_fiber_scheduler_io_result(-1, errno);
+	}
+	
+	return rb_ensure(io_splice_loop, (VALUE)&arguments, io_splice_ensure, (VALUE)&arguments);
+}
+
+#endif
+
+#pragma mark - IO#accept
+
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+
+static inline
+struct IO_Event_Selector_URing_Acceptor * IO_Event_Selector_URing_Acceptor_find(struct IO_Event_Selector_URing *selector, int descriptor)
+{
+	if (descriptor < 0 || (size_t)descriptor >= selector->acceptors.limit) return NULL;
+	
+	return selector->acceptors.base[descriptor];
+}
+
+static inline
+void *IO_Event_Selector_URing_Acceptor_user_data(struct IO_Event_Selector_URing_Acceptor *acceptor)
+{
+	return (void*)((uintptr_t)acceptor | URING_USER_DATA_ACCEPTOR);
+}
+
+static
+void IO_Event_Selector_URing_Acceptor_arm(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Acceptor *acceptor, int descriptor)
+{
+	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_Acceptor_arm:io_uring_prep_multishot_accept(descriptor=%d)\n", descriptor);
 	
 	struct io_uring_sqe *sqe = io_get_sqe(selector);
-	io_uring_prep_write(sqe, arguments->descriptor, arguments->buffer, arguments->length, arguments->offset);
-	io_uring_sqe_set_data(sqe, arguments->waiting->completion);
+	io_uring_prep_multishot_accept(sqe, descriptor, NULL, NULL, SOCK_CLOEXEC);
+	io_set_file(selector, sqe, descriptor);
+	io_uring_sqe_set_data(sqe, IO_Event_Selector_URing_Acceptor_user_data(acceptor));
 	io_uring_submit_pending(selector);
 	
-	IO_Event_Selector_loop_yield(&selector->backend);
-	
-	return RB_INT2NUM(arguments->waiting->result);
+	acceptor->armed = 1;
 }
 
-static VALUE
-io_write_ensure(VALUE _argument)
+// The server descriptor is being closed: fail any waiting fibers, close any queued descriptors and cancel the armed multishot accept, which would otherwise hold a reference to the server socket and keep it listening.
+static
+void IO_Event_Selector_URing_Acceptor_close(struct IO_Event_Selector_URing *selector, int descriptor)
 {
-	struct io_write_arguments *arguments = (struct io_write_arguments*)_argument;
-	struct IO_Event_Selector_URing *selector = arguments->selector;
+	struct IO_Event_Selector_URing_Acceptor *acceptor = IO_Event_Selector_URing_Acceptor_find(selector, descriptor);
+	if (acceptor == NULL) return;
 	
-	// If the operation is still in progress, cancel it:
-	if (arguments->waiting->completion) {
-		if (DEBUG) fprintf(stderr, "io_write_ensure:io_uring_prep_cancel(waiting=%p, completion=%p)\n", (void*)arguments->waiting, (void*)arguments->waiting->completion);
+	while (!IO_Event_List_empty(&acceptor->waiting)) {
+		struct IO_Event_Selector_URing_Acceptor_Waiting *waiting = (struct IO_Event_Selector_URing_Acceptor_Waiting *)acceptor->waiting.tail;
+		IO_Event_List_pop(&waiting->list);
+		
+		waiting->result = -EBADF;
+		waiting->ready = 1;
+		
+		IO_Event_Selector_ready_push(&selector->backend, waiting->fiber);
+	}
+	
+	IO_Event_Selector_URing_Acceptor_reset(acceptor);
+	RB_OBJ_WRITE(selector->backend.self, &acceptor->io, 0);
+	
+	if (acceptor->armed) {
 		struct io_uring_sqe *sqe = io_get_sqe(selector);
-		io_uring_prep_cancel(sqe, (void*)arguments->waiting->completion, 0);
+		io_uring_prep_cancel(sqe, IO_Event_Selector_URing_Acceptor_user_data(acceptor), 0);
 		io_uring_sqe_set_data(sqe, NULL);
 		io_uring_submit_now(selector);
+		
+		// The descriptor may be reused before the final completion arrives, so detach the acceptor:
+		acceptor->orphaned = 1;
+		IO_Event_List_append(&selector->orphaned_acceptors, &acceptor->list);
+		selector->acceptors.base[descriptor] = NULL;
 	}
-	
-	IO_Event_Selector_URing_Waiting_cancel(arguments->waiting);
-	
-	return Qnil;
 }
 
-static int
-io_write(struct IO_Event_Selector_URing *selector, VALUE fiber, int descriptor, char *buffer, size_t length, off_t offset)
+static
+void IO_Event_Selector_URing_Acceptor_enqueue(struct IO_Event_Selector_URing_Acceptor *acceptor, int descriptor)
 {
-	struct IO_Event_Selector_URing_Waiting waiting = {
-		.fiber = fiber,
-	};
-	
-	RB_OBJ_WRITTEN(selector->backend.self, Qundef, fiber);
+	if (acceptor->count == acceptor->capacity) {
+		size_t capacity = acceptor->capacity ? acceptor->capacity * 2 : 16;
+		int *accepted = ALLOC_N(int, capacity);
+		
+		// Unwrap the circular buffer into the new storage:
+		for (size_t i = 0; i < acceptor->count; i += 1) {
+			accepted[i] = acceptor->accepted[(acceptor->head + i) % acceptor->capacity];
+		}
+		
+		if (acceptor->accepted) xfree(acceptor->accepted);
+		
+		acceptor->accepted = accepted;
+		acceptor->capacity = capacity;
+		acceptor->head = 0;
+	}
 	
-	IO_Event_Selector_URing_Completion_acquire(selector, &waiting);
+	acceptor->accepted[(acceptor->head + acceptor->count) % acceptor->capacity] = descriptor;
+	acceptor->count += 1;
+}
+
+static
+int IO_Event_Selector_URing_Acceptor_dequeue(struct IO_Event_Selector_URing_Acceptor *acceptor)
+{
+	int descriptor = acceptor->accepted[acceptor->head];
 	
-	struct io_write_arguments arguments = {
-		.selector = selector,
-		.waiting = &waiting,
-		.descriptor = descriptor,
-		.offset = offset,
-		.buffer = buffer,
-		.length = length,
-	};
+	acceptor->head = (acceptor->head + 1) % acceptor->capacity;
+	acceptor->count -= 1;
 	
-	return RB_NUM2INT(
-		rb_ensure(io_write_submit, (VALUE)&arguments, io_write_ensure, (VALUE)&arguments)
-	);
+	return descriptor;
 }
 
-VALUE IO_Event_Selector_URing_io_write(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _length, VALUE _offset) {
-	struct IO_Event_Selector_URing *selector = NULL;
-	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+// Hand the result to the oldest waiting fiber, if any.
+static
+int IO_Event_Selector_URing_Acceptor_resume(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Acceptor *acceptor, int result)
+{
+	if (IO_Event_List_empty(&acceptor->waiting)) return 0;
 	
-	const void *base;
-	size_t size;
-	rb_io_buffer_get_bytes_for_reading(buffer, &base, &size);
+	struct IO_Event_Selector_URing_Acceptor_Waiting *waiting = (struct IO_Event_Selector_URing_Acceptor_Waiting *)acceptor->waiting.tail;
+	IO_Event_List_pop(&waiting->list);
 	
-	size_t length = NUM2SIZET(_length);
-	size_t offset = NUM2SIZET(_offset);
-	size_t total = 0;
+	waiting->result = result;
+	waiting->ready = 1;
 	
-	if (length > size) {
-		rb_raise(rb_eRuntimeError, "Length exceeds size of buffer!");
-	}
+	IO_Event_Selector_loop_resume(&selector->backend, waiting->fiber, 0, NULL);
+	
+	return 1;
+}
 
-	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
-	if (offset > size) {
-		return rb_fiber_scheduler_io_result(-1, EINVAL);
-	} else if (offset == size) {
-		return rb_fiber_scheduler_io_result(0, 0);
+// Process a completion of the multishot accept for the given acceptor.
+static
+void IO_Event_Selector_URing_Acceptor_complete(struct IO_Event_Selector_URing *selector, struct IO_Event_Selector_URing_Acceptor *acceptor, int32_t result, uint32_t flags)
+{
+	if (DEBUG) fprintf(stderr, "IO_Event_Selector_URing_Acceptor_complete(result=%d, flags=%u)\n", result, flags);
+	
+	if (acceptor->orphaned) {
+		// The server was closed, so connections accepted before the cancellation took effect are discarded:
+		if (result >= 0) close(result);
+		
+		if (!(flags & IORING_CQE_F_MORE)) {
+			IO_Event_List_pop(&acceptor->list);
+			IO_Event_Selector_URing_Acceptor_free(acceptor);
+			xfree(acceptor);
+		}
+		
+		return;
 	}
 	
-	int descriptor = IO_Event_Selector_io_descriptor(io);
-	off_t from = io_seekable(descriptor);
+	// If the kernel is not going to produce further completions, the accept must be armed again:
+	if (!(flags & IORING_CQE_F_MORE)) {
+		acceptor->armed = 0;
+	}
 	
-	size_t maximum_size = size - offset;
-	while (maximum_size) {
-		int result = io_write(selector, fiber, descriptor, (char*)base+offset, maximum_size, from);
+	if (result >= 0) {
+		if (!IO_Event_Selector_URing_Acceptor_resume(selector, acceptor, result)) {
+			IO_Event_Selector_URing_Acceptor_enqueue(acceptor, result);
+		}
+	} else if (!acceptor->armed) {
+		// The multishot accept was terminated by an error, which is delivered to every fiber that was waiting (but not to fibers which start waiting as a result):
+		size_t count = 0;
+		for (struct IO_Event_List *node = acceptor->waiting.tail; node != &acceptor->waiting; node = node->tail) count += 1;
 		
-		if (result > 0) {
-			total += result;
-			offset += result;
-			if ((size_t)result >= length) break;
-			length -= result;
-		} else if (result == 0) {
-			break;
-		} else if (length > 0 && IO_Event_try_again(-result)) {
-			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_WRITABLE));
-		} else {
-			return rb_fiber_scheduler_io_result(-1, -result);
+		if (count == 0) {
+			acceptor->error = result;
 		}
 		
-		maximum_size = size - offset;
+		while (count-- > 0 && IO_Event_Selector_URing_Acceptor_resume(selector, acceptor, result));
 	}
-	
-	return rb_fiber_scheduler_io_result(total, 0);
 }
 
-static VALUE IO_Event_Selector_URing_io_write_compatible(int argc, VALUE *argv, VALUE self)
-{
-	rb_check_arity(argc, 4, 5);
-	
-	VALUE _offset = SIZET2NUM(0);
+struct io_accept_arguments {
+	struct IO_Event_Selector_URing *selector;
+	struct IO_Event_Selector_URing_Acceptor_Waiting *waiting;
+};
+
+static
+VALUE io_accept_transfer(VALUE _arguments) {
+	struct io_accept_arguments *arguments = (struct io_accept_arguments *)_arguments;
 	
-	if (argc == 5) {
-		_offset = argv[4];
+	while (!arguments->waiting->ready) {
+		IO_Event_Selector_loop_yield(&arguments->selector->backend);
 	}
 	
-	return IO_Event_Selector_URing_io_write(self, argv[0], argv[1], argv[2], argv[3], _offset);
+	return Qnil;
 }
 
-VALUE IO_Event_Selector_URing_io_pwrite(VALUE self, VALUE fiber, VALUE io, VALUE buffer, VALUE _from, VALUE _length, VALUE _offset) {
+static
+VALUE io_accept_ensure(VALUE _arguments) {
+	struct io_accept_arguments *arguments = (struct io_accept_arguments *)_arguments;
+	
+	// If we were interrupted, stop waiting. The multishot accept remains armed and further connections are queued:
+	IO_Event_List_free(&arguments->waiting->list);
+	
+	return Qnil;
+}
+
+// Accept a connection on the given server, using a multishot accept which remains armed across calls. Connections accepted while no fiber is waiting are queued, so an accept loop only costs a submission when the multishot accept needs to be (re-)armed.
+//
+// Returns the accepted file descriptor (with `FD_CLOEXEC` set) as an Integer.
+VALUE IO_Event_Selector_URing_io_accept(VALUE self, VALUE fiber, VALUE io) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
-	const void *base;
-	size_t size;
-	rb_io_buffer_get_bytes_for_reading(buffer, &base, &size);
-	
-	size_t length = NUM2SIZET(_length);
-	size_t offset = NUM2SIZET(_offset);
-	size_t total = 0;
-	off_t from = NUM2OFFT(_from);
+	int descriptor = IO_Event_Selector_URing_io_descriptor(selector, io);
+	struct IO_Event_Selector_URing_Acceptor *acceptor = IO_Event_Array_lookup(&selector->acceptors, descriptor);
 	
-	if (length > size) {
-		rb_raise(rb_eRuntimeError, "Length exceeds size of buffer!");
-	}
-
-	// Ensure offset is within the bounds of the buffer to avoid size_t underflow and out-of-bounds pointer arithmetic on (char *)base + offset.
-	if (offset > size) {
-		return rb_fiber_scheduler_io_result(-1, EINVAL);
-	} else if (offset == size) {
-		return rb_fiber_scheduler_io_result(0, 0);
+	if (acceptor->io != io) {
+		if (acceptor->io) {
+			// The previous server was closed without `io_close`, so its connections (and its armed multishot accept) must not be handed to this one:
+			IO_Event_Selector_URing_Acceptor_close(selector, descriptor);
+			acceptor = IO_Event_Array_lookup(&selector->acceptors, descriptor);
+		}
+		
+		RB_OBJ_WRITE(self, &acceptor->io, io);
 	}
 	
-	int descriptor = IO_Event_Selector_io_descriptor(io);
+	int result = 0;
 	
-	size_t maximum_size = size - offset;
-	while (maximum_size) {
-		int result = io_write(selector, fiber, descriptor, (char*)base+offset, maximum_size, from);
-		
-		if (result > 0) {
-			total += result;
-			offset += result;
-			from += result;
-			if ((size_t)result >= length) break;
-			length -= result;
-		} else if (result == 0) {
-			break;
-		} else if (length > 0 && IO_Event_try_again(-result)) {
-			IO_Event_Selector_URing_io_wait(self, fiber, io, RB_INT2NUM(IO_EVENT_WRITABLE));
-		} else {
-			return rb_fiber_scheduler_io_result(-1, -result);
+	if (acceptor->count > 0) {
+		result = IO_Event_Selector_URing_Acceptor_dequeue(acceptor);
+	} else if (acceptor->error) {
+		result = acceptor->error;
+		acceptor->error = 0;
+	} else {
+		if (!acceptor->armed) {
+			IO_Event_Selector_URing_Acceptor_arm(selector, acceptor, descriptor);
 		}
 		
-		maximum_size = size - offset;
+		struct IO_Event_Selector_URing_Acceptor_Waiting waiting = {
+			.fiber = fiber,
+		};
+		
+		RB_OBJ_WRITTEN(self, Qundef, fiber);
+		
+		IO_Event_List_append(&acceptor->waiting, &waiting.list);
+		
+		struct io_accept_arguments io_accept_arguments = {
+			.selector = selector,
+			.waiting = &waiting,
+		};
+		
+		rb_ensure(io_accept_transfer, (VALUE)&io_accept_arguments, io_accept_ensure, (VALUE)&io_accept_arguments);
+		
+		result = waiting.result;
 	}
 	
-	return rb_fiber_scheduler_io_result(total, 0);
+	if (result < 0) {
+		rb_syserr_fail(-result, "IO_Event_Selector_URing_io_accept:io_uring_prep_multishot_accept");
+	}
+	
+	rb_update_max_fd(result);
+	
+	return RB_INT2NUM(result);
 }
 
 #endif
@@ -1193,6 +3875,22 @@ VALUE IO_Event_Selector_URing_io_close(VALUE self, VALUE _descriptor) {
 	// Ruby's fiber scheduler `io_close` hook is invoked with a raw integer file descriptor (Ruby 4.0+); it does not pass the `IO` object.
 	int descriptor = RB_NUM2INT(_descriptor);
 	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	IO_Event_Selector_URing_Acceptor_close(selector, descriptor);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	IO_Event_Selector_URing_Poller_close(selector, descriptor);
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	IO_Event_Selector_URing_File_unregister(selector, descriptor);
+#endif
+	
+#ifdef HAVE_RUBY_IO_BUFFER_H
+	IO_Event_Selector_URing_Descriptor_close(selector, descriptor);
+#endif
+	
 	if (ASYNC_CLOSE) {
 		struct io_uring_sqe *sqe = io_get_sqe(selector);
 		io_uring_prep_close(sqe, descriptor);
@@ -1305,6 +4003,13 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 	unsigned head;
 	struct io_uring_cqe *cqe;
 	
+	// The time at which the completions were found, to measure how long each fiber waits to be resumed:
+	struct timespec ready_time;
+	int latency_tracking = selector->backend.latency_tracking;
+	if (latency_tracking) {
+		IO_Event_Time_current(&ready_time);
+	}
+	
 	if (DEBUG) {
 		fprintf(stderr, "select_process_completions: selector=%p\n", (void*)selector);
 		IO_Event_Selector_URing_dump_completion_queue(selector);
@@ -1314,6 +4019,7 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 		if (DEBUG_CQE) fprintf(stderr, "select_process_completions: cqe res=%d user_data=%p\n", cqe->res, (void*)cqe->user_data);
 		
 		++completed;
+		selector->backend.statistics.events += 1;
 		
 		// If the operation was cancelled, or the operation has no user data:
 		if (cqe->user_data == 0 || cqe->user_data == LIBURING_UDATA_TIMEOUT) {
@@ -1321,6 +4027,32 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 			continue;
 		}
 		
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+		if (cqe->user_data & URING_USER_DATA_ACCEPTOR) {
+			struct IO_Event_Selector_URing_Acceptor *acceptor = (void*)(uintptr_t)(cqe->user_data & ~(uint64_t)URING_USER_DATA_ACCEPTOR);
+			int32_t result = cqe->res;
+			uint32_t flags = cqe->flags;
+			
+			io_uring_cq_advance(ring, 1);
+			
+			IO_Event_Selector_URing_Acceptor_complete(selector, acceptor, result, flags);
+			continue;
+		}
+#endif
+		
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+		if (cqe->user_data & URING_USER_DATA_POLLER) {
+			struct IO_Event_Selector_URing_Poller *poller = (void*)(uintptr_t)(cqe->user_data & ~(uint64_t)URING_USER_DATA_POLLER);
+			int32_t result = cqe->res;
+			uint32_t flags = cqe->flags;
+			
+			io_uring_cq_advance(ring, 1);
+			
+			IO_Event_Selector_URing_Poller_complete(selector, poller, result, flags);
+			continue;
+		}
+#endif
+		
 		// Interrupt read completion — the read already consumed the counter.
 		// Clear the flag so the next blocking wait re-submits the read.
 		if (io_uring_cqe_get_data(cqe) == &selector->interrupt) {
@@ -1334,17 +4066,35 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 		
 		if (DEBUG) fprintf(stderr, "select_process_completions: completion=%p waiting=%p\n", (void*)completion, (void*)waiting);
 		
-		if (waiting) {
+		uint32_t flags = cqe->flags;
+		int notification = 0;
+		
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+		// The notification for a zero-copy send carries no result, the result was posted by the previous completion:
+		notification = flags & IORING_CQE_F_NOTIF;
+#endif
+		
+		if (waiting && !notification) {
 			waiting->result = cqe->res;
-			waiting->flags = cqe->flags;
+			waiting->flags = flags;
+		}
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+		else if (flags & IORING_CQE_F_BUFFER) {
+			// The operation was cancelled after the kernel selected a buffer, so nobody will consume it:
+			IO_Event_Selector_URing_buffers_recycle(selector, flags >> IORING_CQE_BUFFER_SHIFT);
 		}
+#endif
 		
 		io_uring_cq_advance(ring, 1);
 		
+		// The operation will post further completions (e.g. the notification for a zero-copy send), so it is not complete yet:
+		if (flags & IORING_CQE_F_MORE) {
+			continue;
+		}
+		
 		VALUE fiber = 0;
 		if (waiting && waiting->fiber) {
-			assert(waiting->result != -ECANCELED);
-			
+			// Operations can only be cancelled while a fiber is still waiting if they had a linked timeout which expired.
 			fiber = waiting->fiber;
 		}
 
@@ -1352,6 +4102,10 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 		IO_Event_Selector_URing_Completion_release(selector, completion);
 		
 		if (fiber) {
+			if (latency_tracking) {
+				IO_Event_Selector_latency_record(&selector->backend, &ready_time);
+			}
+			
 			IO_Event_Selector_loop_resume(&selector->backend, fiber, 0, NULL);
 		}
 	}
@@ -1361,6 +4115,21 @@ unsigned select_process_completions(struct IO_Event_Selector_URing *selector) {
 	return completed;
 }
 
+// Process completions without blocking, used while spinning before a blocking wait.
+static
+int select_spin_poll(void *_selector) {
+	struct IO_Event_Selector_URing *selector = _selector;
+	
+#ifdef IORING_SETUP_DEFER_TASKRUN
+	// Run any pending task work, so that completions are posted to the completion queue:
+	if (!io_uring_cq_ready(&selector->ring)) {
+		io_uring_get_events(&selector->ring);
+	}
+#endif
+	
+	return select_process_completions(selector);
+}
+
 VALUE IO_Event_Selector_URing_select(VALUE self, VALUE duration) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
@@ -1368,9 +4137,16 @@ VALUE IO_Event_Selector_URing_select(VALUE self, VALUE duration) {
 	selector->idle_duration.tv_sec = 0;
 	selector->idle_duration.tv_nsec = 0;
 	
+	selector->backend.statistics.selects += 1;
+	
 	// Flush any pending events:
 	io_uring_submit_flush(selector);
 	
+	// Completions which didn't fit in the completion queue are held by the kernel until the next `io_uring_enter`, which is a sign that the completion queue is too small:
+	if (__atomic_load_n(selector->ring.sq.kflags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) {
+		selector->completion_queue_overflow += 1;
+	}
+	
 #ifdef IORING_SETUP_DEFER_TASKRUN
 	// With DEFER_TASKRUN the kernel holds completions as "deferred task work"
 	// rather than placing them directly into the CQ.  We need to flush that work
@@ -1409,7 +4185,28 @@ VALUE IO_Event_Selector_URing_select(VALUE self, VALUE duration) {
 		
 		arguments.timeout = make_timeout(duration, &arguments.storage);
 		
-		if (!selector->backend.ready && select_blocking_allowed(arguments.timeout)) {
+		if (select_blocking_allowed(arguments.timeout)) {
+			// Keep polling for a short while, as completions which arrive soon are cheaper to pick up without releasing the GVL and blocking:
+			struct timespec timeout, *remaining = NULL;
+			
+			// The ring uses `__kernel_timespec`, so convert the timeout while spinning:
+			if (arguments.timeout) {
+				timeout.tv_sec = arguments.timeout->tv_sec;
+				timeout.tv_nsec = arguments.timeout->tv_nsec;
+				remaining = &timeout;
+			}
+			
+			completed = IO_Event_Selector_spin_wait(&selector->backend, remaining, select_spin_poll, selector);
+			
+			if (arguments.timeout) {
+				arguments.timeout->tv_sec = timeout.tv_sec;
+				arguments.timeout->tv_nsec = timeout.tv_nsec;
+			}
+		}
+		
+		if (!completed && !selector->backend.ready && select_blocking_allowed(arguments.timeout)) {
+			selector->backend.statistics.blocking_waits += 1;
+			
 			struct timespec start_time;
 			IO_Event_Time_current(&start_time);
 			
@@ -1430,13 +4227,58 @@ VALUE IO_Event_Selector_URing_select(VALUE self, VALUE duration) {
 	return RB_INT2NUM(completed);
 }
 
+VALUE IO_Event_Selector_URing_spin(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return IO_Event_Selector_spin(&selector->backend);
+}
+
+// Keep polling the completion queue for up to the given number of seconds before releasing the GVL and blocking, which avoids a context switch when completions arrive soon after the selector runs out of work. `statistics` reports how often spinning found completions.
+VALUE IO_Event_Selector_URing_spin_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	IO_Event_Selector_spin_set(&selector->backend, value);
+	
+	return value;
+}
+
+VALUE IO_Event_Selector_URing_latency_tracking(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return selector->backend.latency_tracking ? Qtrue : Qfalse;
+}
+
+// Record how long fibers wait between becoming ready (being pushed to the ready queue, or their completion being returned by the kernel) and being resumed. Enabling it clears the histogram.
+VALUE IO_Event_Selector_URing_latency_tracking_set(VALUE self, VALUE value) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	IO_Event_Selector_latency_tracking_set(&selector->backend, value);
+	
+	return value;
+}
+
+// A log2 histogram of scheduling latency, where index `i` counts delays of at least `2**(i-1)` and less than `2**i` nanoseconds, or `nil` if latency tracking is disabled.
+VALUE IO_Event_Selector_URing_latency_histogram(VALUE self) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	return IO_Event_Selector_latency_histogram(&selector->backend);
+}
+
 VALUE IO_Event_Selector_URing_wakeup(VALUE self) {
 	struct IO_Event_Selector_URing *selector = NULL;
 	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
 	
+	selector->backend.statistics.wakeups += 1;
+	
 	// Wake the selector by signalling the interrupt. This is safe from any thread
 	// and never touches the ring's SQ, which is required for IORING_SETUP_SINGLE_ISSUER.
 	if (selector->backend.blocked) {
+		selector->backend.statistics.wakeup_signals += 1;
 		IO_Event_Interrupt_signal(&selector->interrupt);
 		return Qtrue;
 	}
@@ -1444,6 +4286,18 @@ VALUE IO_Event_Selector_URing_wakeup(VALUE self) {
 	return Qfalse;
 }
 
+// Append the given fiber to the ready queue from any thread, e.g. to hand work from a background thread to the event loop. The event loop is woken up if it is blocked, once for all the fibers pushed before it runs again.
+VALUE IO_Event_Selector_URing_push_remote(VALUE self, VALUE fiber) {
+	struct IO_Event_Selector_URing *selector = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Selector_URing, &IO_Event_Selector_URing_Type, selector);
+	
+	if (IO_Event_Selector_remote_push(&selector->backend, fiber)) {
+		IO_Event_Selector_URing_wakeup(self);
+	}
+	
+	return Qnil;
+}
+
 #pragma mark - Native Methods
 
 static int IO_Event_Selector_URing_supported_p(void) {
@@ -1489,16 +4343,30 @@ void Init_IO_Event_Selector_URing(VALUE IO_Event_Selector) {
 	
 	VALUE IO_Event_Selector_URing = rb_define_class_under(IO_Event_Selector, "URing", rb_cObject);
 	
+	id_entries = rb_intern("entries");
+	id_completion_entries = rb_intern("completion_entries");
+	id_sqpoll = rb_intern("sqpoll");
+	id_sq_thread_cpu = rb_intern("sq_thread_cpu");
+	id_sq_thread_idle = rb_intern("sq_thread_idle");
+	
 	rb_define_alloc_func(IO_Event_Selector_URing, IO_Event_Selector_URing_allocate);
-	rb_define_method(IO_Event_Selector_URing, "initialize", IO_Event_Selector_URing_initialize, 1);
+	rb_define_method(IO_Event_Selector_URing, "initialize", IO_Event_Selector_URing_initialize, -1);
 	
 	rb_define_method(IO_Event_Selector_URing, "loop", IO_Event_Selector_URing_loop, 0);
 	rb_define_method(IO_Event_Selector_URing, "idle_duration", IO_Event_Selector_URing_idle_duration, 0);
+	rb_define_method(IO_Event_Selector_URing, "statistics", IO_Event_Selector_URing_statistics, 0);
+	rb_define_method(IO_Event_Selector_URing, "spin", IO_Event_Selector_URing_spin, 0);
+	rb_define_method(IO_Event_Selector_URing, "spin=", IO_Event_Selector_URing_spin_set, 1);
+	rb_define_method(IO_Event_Selector_URing, "latency_tracking", IO_Event_Selector_URing_latency_tracking, 0);
+	rb_define_method(IO_Event_Selector_URing, "latency_tracking=", IO_Event_Selector_URing_latency_tracking_set, 1);
+	rb_define_method(IO_Event_Selector_URing, "latency_histogram", IO_Event_Selector_URing_latency_histogram, 0);
+	rb_define_method(IO_Event_Selector_URing, "sqpoll?", IO_Event_Selector_URing_sqpoll_p, 0);
 	
 	rb_define_method(IO_Event_Selector_URing, "transfer", IO_Event_Selector_URing_transfer, 0);
 	rb_define_method(IO_Event_Selector_URing, "resume", IO_Event_Selector_URing_resume, -1);
 	rb_define_method(IO_Event_Selector_URing, "yield", IO_Event_Selector_URing_yield, 0);
 	rb_define_method(IO_Event_Selector_URing, "push", IO_Event_Selector_URing_push, 1);
+	rb_define_method(IO_Event_Selector_URing, "push_remote", IO_Event_Selector_URing_push_remote, 1);
 	rb_define_method(IO_Event_Selector_URing, "raise", IO_Event_Selector_URing_raise, -1);
 	
 	rb_define_method(IO_Event_Selector_URing, "ready?", IO_Event_Selector_URing_ready_p, 0);
@@ -1508,16 +4376,50 @@ void Init_IO_Event_Selector_URing(VALUE IO_Event_Selector) {
 	rb_define_method(IO_Event_Selector_URing, "close", IO_Event_Selector_URing_close, 0);
 	rb_define_method(IO_Event_Selector_URing, "closed?", IO_Event_Selector_URing_closed_p, 0);
 	
-	rb_define_method(IO_Event_Selector_URing, "io_wait", IO_Event_Selector_URing_io_wait, 3);
+	rb_define_method(IO_Event_Selector_URing, "io_wait", IO_Event_Selector_URing_io_wait_compatible, -1);
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_POLL
+	rb_define_method(IO_Event_Selector_URing, "multishot_poll", IO_Event_Selector_URing_multishot_poll, 0);
+	rb_define_method(IO_Event_Selector_URing, "multishot_poll=", IO_Event_Selector_URing_multishot_poll_set, 1);
+#endif
 	
 #ifdef HAVE_RUBY_IO_BUFFER_H
 	rb_define_method(IO_Event_Selector_URing, "io_read", IO_Event_Selector_URing_io_read_compatible, -1);
 	rb_define_method(IO_Event_Selector_URing, "io_write", IO_Event_Selector_URing_io_write_compatible, -1);
 	rb_define_method(IO_Event_Selector_URing, "io_pread", IO_Event_Selector_URing_io_pread, 6);
 	rb_define_method(IO_Event_Selector_URing, "io_pwrite", IO_Event_Selector_URing_io_pwrite, 6);
+	rb_define_method(IO_Event_Selector_URing, "io_readv", IO_Event_Selector_URing_io_readv, 3);
+	rb_define_method(IO_Event_Selector_URing, "io_writev", IO_Event_Selector_URing_io_writev, 3);
+	rb_define_method(IO_Event_Selector_URing, "io_splice", IO_Event_Selector_URing_io_splice, 4);
+	rb_define_method(IO_Event_Selector_URing, "optimistic_io", IO_Event_Selector_URing_optimistic_io, 0);
+	rb_define_method(IO_Event_Selector_URing, "optimistic_io=", IO_Event_Selector_URing_optimistic_io_set, 1);
+	
+#ifdef IO_EVENT_SELECTOR_URING_SEND_ZC
+	rb_define_method(IO_Event_Selector_URing, "zero_copy_threshold", IO_Event_Selector_URing_zero_copy_threshold, 0);
+	rb_define_method(IO_Event_Selector_URing, "zero_copy_threshold=", IO_Event_Selector_URing_zero_copy_threshold_set, 1);
 #endif
 	
+#ifdef IO_EVENT_SELECTOR_URING_BUFFER_RING
+	rb_define_method(IO_Event_Selector_URing, "provide_buffers", IO_Event_Selector_URing_provide_buffers, 2);
+	rb_define_method(IO_Event_Selector_URing, "io_read_provided", IO_Event_Selector_URing_io_read_provided, 2);
+#endif
+#endif
+	
+#ifdef IO_EVENT_SELECTOR_URING_MULTISHOT_ACCEPT
+	rb_define_method(IO_Event_Selector_URing, "io_accept", IO_Event_Selector_URing_io_accept, 2);
+#endif
+	
+	rb_define_method(IO_Event_Selector_URing, "io_open", IO_Event_Selector_URing_io_open, 4);
+	rb_define_method(IO_Event_Selector_URing, "io_stat", IO_Event_Selector_URing_io_stat, 2);
+	rb_define_method(IO_Event_Selector_URing, "io_fsync", IO_Event_Selector_URing_io_fsync, -1);
+	rb_define_method(IO_Event_Selector_URing, "io_fallocate", IO_Event_Selector_URing_io_fallocate, 4);
+	
 	rb_define_method(IO_Event_Selector_URing, "io_close", IO_Event_Selector_URing_io_close, 1);
 	
+#ifdef IO_EVENT_SELECTOR_URING_FIXED_FILES
+	rb_define_method(IO_Event_Selector_URing, "register", IO_Event_Selector_URing_register, 1);
+	rb_define_method(IO_Event_Selector_URing, "unregister", IO_Event_Selector_URing_unregister, 1);
+#endif
+	
 	rb_define_method(IO_Event_Selector_URing, "process_wait", IO_Event_Selector_URing_process_wait, 3);
 }
@@ -0,0 +1,563 @@
+// Released under the MIT License.
+// Copyright, 2026, by Samuel Williams.
+
+#include "timers.h"
+
+#include <time.h>
+
+enum {
+	DEBUG = 0,
+};
+
+enum {
+	// Mirrors `IO::Event::Timers::COMPACT_MINIMUM_COUNT`.
+	IO_EVENT_TIMERS_COMPACT_MINIMUM_COUNT = 128,
+
+	// Mirrors `IO::Event::PriorityHeap::HEAPIFY_INSERT_RATIO`.
+	IO_EVENT_TIMERS_HEAPIFY_INSERT_RATIO = 2,
+
+	IO_EVENT_TIMERS_DEFAULT_CAPACITY = 64,
+};
+
+static VALUE IO_Event_NativeTimers = Qnil;
+static VALUE IO_Event_NativeTimers_Handle = Qnil;
+
+static ID id_call, id_to_f;
+
+#pragma mark - Handle
+
+struct IO_Event_Timers_Handle {
+	// The time at which the block should be called:
+	double time;
+
+	// The block to call, or `Qnil` if the handle was cancelled:
+	VALUE block;
+
+	// The timers instance while the handle is retained in the heap, otherwise `Qnil`:
+	VALUE timers;
+};
+
+static void IO_Event_Timers_Handle_Type_mark(void *_handle)
+{
+	struct IO_Event_Timers_Handle *handle = _handle;
+
+	rb_gc_mark_movable(handle->block);
+	rb_gc_mark_movable(handle->timers);
+}
+
+static void IO_Event_Timers_Handle_Type_compact(void *_handle)
+{
+	struct IO_Event_Timers_Handle *handle = _handle;
+
+	handle->block = rb_gc_location(handle->block);
+	handle->timers = rb_gc_location(handle->timers);
+}
+
+static size_t IO_Event_Timers_Handle_Type_size(const void *_handle)
+{
+	return sizeof(struct IO_Event_Timers_Handle);
+}
+
+static const rb_data_type_t IO_Event_Timers_Handle_Type = {
+	.wrap_struct_name = "IO::Event::NativeTimers::Handle",
+	.function = {
+		.dmark = IO_Event_Timers_Handle_Type_mark,
+		.dcompact = IO_Event_Timers_Handle_Type_compact,
+		.dfree = RUBY_TYPED_DEFAULT_FREE,
+		.dsize = IO_Event_Timers_Handle_Type_size,
+	},
+	.data = NULL,
+	.flags = RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_WB_PROTECTED,
+};
+
+static inline struct IO_Event_Timers_Handle * IO_Event_Timers_Handle_get(VALUE self)
+{
+	struct IO_Event_Timers_Handle *handle = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Timers_Handle, &IO_Event_Timers_Handle_Type, handle);
+
+	return handle;
+}
+
+static inline int IO_Event_Timers_Handle_cancelled_p(const struct IO_Event_Timers_Handle *handle)
+{
+	return NIL_P(handle->block);
+}
+
+#pragma mark - Entries
+
+// Deadlines are stored inline next to their handle, so heap operations compare packed doubles in a contiguous array without dereferencing any Ruby objects.
+struct IO_Event_Timers_Entry {
+	double time;
+	VALUE handle;
+};
+
+struct IO_Event_Timers_Entries {
+	struct IO_Event_Timers_Entry *base;
+	size_t size;
+	size_t capacity;
+};
+
+// Ensure there is space for at least `count` entries. Raises `NoMemoryError` if Ruby's allocator cannot satisfy the request.
+static inline void IO_Event_Timers_Entries_reserve(struct IO_Event_Timers_Entries *entries, size_t count)
+{
+	if (count <= entries->capacity) return;
+
+	size_t capacity = entries->capacity ? entries->capacity : IO_EVENT_TIMERS_DEFAULT_CAPACITY;
+	while (capacity < count) capacity *= 2;
+
+	// `xrealloc2` checks `capacity * sizeof(...)` for overflow, so no further checks are required.
+	entries->base = xrealloc2(entries->base, capacity, sizeof(struct IO_Event_Timers_Entry));
+	entries->capacity = capacity;
+}
+
+static inline void IO_Event_Timers_Entries_free(struct IO_Event_Timers_Entries *entries)
+{
+	if (entries->base) {
+		xfree(entries->base);
+		entries->base = NULL;
+	}
+
+	entries->size = 0;
+	entries->capacity = 0;
+}
+
+static void IO_Event_Timers_Entries_mark(struct IO_Event_Timers_Entries *entries)
+{
+	for (size_t i = 0; i < entries->size; i += 1) {
+		rb_gc_mark_movable(entries->base[i].handle);
+	}
+}
+
+static void IO_Event_Timers_Entries_compact(struct IO_Event_Timers_Entries *entries)
+{
+	for (size_t i = 0; i < entries->size; i += 1) {
+		entries->base[i].handle = rb_gc_location(entries->base[i].handle);
+	}
+}
+
+#pragma mark - Heap
+
+// A binary min-heap keyed on `time`. See `IO::Event::PriorityHeap` for the equivalent pure Ruby implementation.
+
+static void IO_Event_Timers_heap_bubble_up(struct IO_Event_Timers_Entry *base, size_t index)
+{
+	struct IO_Event_Timers_Entry entry = base[index];
+
+	while (index > 0) {
+		size_t parent = (index - 1) / 2;
+
+		if (!(entry.time < base[parent].time)) break;
+
+		base[index] = base[parent];
+		index = parent;
+	}
+
+	base[index] = entry;
+}
+
+static void IO_Event_Timers_heap_bubble_down(struct IO_Event_Timers_Entry *base, size_t size, size_t index)
+{
+	struct IO_Event_Timers_Entry entry = base[index];
+
+	while (1) {
+		size_t child = (2 * index) + 1;
+		if (child >= size) break;
+
+		// Select the smallest of the two children:
+		size_t right = child + 1;
+		if (right < size && base[right].time < base[child].time) {
+			child = right;
+		}
+
+		if (!(base[child].time < entry.time)) break;
+
+		base[index] = base[child];
+		index = child;
+	}
+
+	base[index] = entry;
+}
+
+// Rebuild the heap property from an arbitrary array in O(n) time.
+static void IO_Event_Timers_heapify(struct IO_Event_Timers_Entries *heap)
+{
+	if (heap->size <= 1) return;
+
+	for (size_t index = heap->size / 2; index > 0; index -= 1) {
+		IO_Event_Timers_heap_bubble_down(heap->base, heap->size, index - 1);
+	}
+}
+
+static void IO_Event_Timers_heap_pop(struct IO_Event_Timers_Entries *heap)
+{
+	heap->size -= 1;
+
+	if (heap->size > 0) {
+		heap->base[0] = heap->base[heap->size];
+		IO_Event_Timers_heap_bubble_down(heap->base, heap->size, 0);
+	}
+}
+
+// Append the given entries to the heap, choosing between incremental insertion and a single `heapify` pass, in the same way as `IO::Event::PriorityHeap#concat`.
+static void IO_Event_Timers_heap_concat(struct IO_Event_Timers_Entries *heap, const struct IO_Event_Timers_Entries *entries)
+{
+	if (entries->size == 0) return;
+
+	IO_Event_Timers_Entries_reserve(heap, heap->size + entries->size);
+
+	if (heap->size == 0 || entries->size > heap->size * IO_EVENT_TIMERS_HEAPIFY_INSERT_RATIO) {
+		memcpy(heap->base + heap->size, entries->base, entries->size * sizeof(struct IO_Event_Timers_Entry));
+		heap->size += entries->size;
+
+		IO_Event_Timers_heapify(heap);
+	} else {
+		for (size_t i = 0; i < entries->size; i += 1) {
+			heap->base[heap->size] = entries->base[i];
+			heap->size += 1;
+
+			IO_Event_Timers_heap_bubble_up(heap->base, heap->size - 1);
+		}
+	}
+}
+
+#pragma mark - Timers
+
+struct IO_Event_Timers {
+	// A binary min-heap of entries ordered by time:
+	struct IO_Event_Timers_Entries heap;
+
+	// Entries scheduled since the last flush:
+	struct IO_Event_Timers_Entries scheduled;
+
+	// The number of cancelled handles still retained in the heap:
+	size_t cancelled;
+};
+
+static void IO_Event_Timers_Type_mark(void *_timers)
+{
+	struct IO_Event_Timers *timers = _timers;
+
+	IO_Event_Timers_Entries_mark(&timers->heap);
+	IO_Event_Timers_Entries_mark(&timers->scheduled);
+}
+
+static void IO_Event_Timers_Type_compact(void *_timers)
+{
+	struct IO_Event_Timers *timers = _timers;
+
+	IO_Event_Timers_Entries_compact(&timers->heap);
+	IO_Event_Timers_Entries_compact(&timers->scheduled);
+}
+
+static void IO_Event_Timers_Type_free(void *_timers)
+{
+	struct IO_Event_Timers *timers = _timers;
+
+	IO_Event_Timers_Entries_free(&timers->heap);
+	IO_Event_Timers_Entries_free(&timers->scheduled);
+
+	xfree(timers);
+}
+
+static size_t IO_Event_Timers_Type_size(const void *_timers)
+{
+	const struct IO_Event_Timers *timers = _timers;
+
+	return sizeof(struct IO_Event_Timers)
+		+ (timers->heap.capacity + timers->scheduled.capacity) * sizeof(struct IO_Event_Timers_Entry)
+	;
+}
+
+static const rb_data_type_t IO_Event_Timers_Type = {
+	.wrap_struct_name = "IO::Event::NativeTimers",
+	.function = {
+		.dmark = IO_Event_Timers_Type_mark,
+		.dcompact = IO_Event_Timers_Type_compact,
+		.dfree = IO_Event_Timers_Type_free,
+		.dsize = IO_Event_Timers_Type_size,
+	},
+	.data = NULL,
+	.flags = RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_WB_PROTECTED,
+};
+
+static inline struct IO_Event_Timers * IO_Event_Timers_get(VALUE self)
+{
+	struct IO_Event_Timers *timers = NULL;
+	TypedData_Get_Struct(self, struct IO_Event_Timers, &IO_Event_Timers_Type, timers);
+
+	return timers;
+}
+
+static VALUE IO_Event_Timers_allocate(VALUE klass)
+{
+	struct IO_Event_Timers *timers = NULL;
+
+	// The structure is zero-initialized, so both entry arrays start out empty:
+	return TypedData_Make_Struct(klass, struct IO_Event_Timers, &IO_Event_Timers_Type, timers);
+}
+
+static inline double IO_Event_Timers_current_time(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	// Equivalent to `Process.clock_gettime(Process::CLOCK_MONOTONIC)`:
+	return time.tv_sec + (time.tv_nsec / 1000000000.0);
+}
+
+// Flush all scheduled timers into the heap.
+//
+// Scheduling appends to `scheduled` and cancellation is `O(1)`. We pay the cost of filtering and heap repair here, where we can batch work and choose between incremental insertion and one `heapify` pass. See `IO::Event::Timers#flush!` for the equivalent pure Ruby implementation.
+static void IO_Event_Timers_flush(VALUE self, struct IO_Event_Timers *timers)
+{
+	struct IO_Event_Timers_Entries *heap = &timers->heap;
+	struct IO_Event_Timers_Entries *scheduled = &timers->scheduled;
+
+	if (timers->cancelled >= IO_EVENT_TIMERS_COMPACT_MINIMUM_COUNT && timers->cancelled * 2 > heap->size) {
+		if (DEBUG) fprintf(stderr, "IO_Event_Timers_flush: compacting heap size=%zu cancelled=%zu\n", heap->size, timers->cancelled);
+
+		// Remove retained cancelled handles and append live scheduled handles, then rebuild the heap in a single pass:
+		size_t size = 0;
+		for (size_t i = 0; i < heap->size; i += 1) {
+			if (!IO_Event_Timers_Handle_cancelled_p(IO_Event_Timers_Handle_get(heap->base[i].handle))) {
+				heap->base[size] = heap->base[i];
+				size += 1;
+			}
+		}
+		heap->size = size;
+
+		IO_Event_Timers_Entries_reserve(heap, heap->size + scheduled->size);
+
+		for (size_t i = 0; i < scheduled->size; i += 1) {
+			VALUE handle = scheduled->base[i].handle;
+			struct IO_Event_Timers_Handle *timer = IO_Event_Timers_Handle_get(handle);
+
+			if (!IO_Event_Timers_Handle_cancelled_p(timer)) {
+				RB_OBJ_WRITE(handle, &timer->timers, self);
+
+				heap->base[heap->size] = scheduled->base[i];
+				heap->size += 1;
+			}
+		}
+
+		IO_Event_Timers_heapify(heap);
+
+		timers->cancelled = 0;
+	} else {
+		// Filter scheduled handles in place before insertion, which keeps cancelled scheduled handles out of the heap:
+		size_t size = 0;
+		for (size_t i = 0; i < scheduled->size; i += 1) {
+			VALUE handle = scheduled->base[i].handle;
+			struct IO_Event_Timers_Handle *timer = IO_Event_Timers_Handle_get(handle);
+
+			if (!IO_Event_Timers_Handle_cancelled_p(timer)) {
+				RB_OBJ_WRITE(handle, &timer->timers, self);
+
+				scheduled->base[size] = scheduled->base[i];
+				size += 1;
+			}
+		}
+		scheduled->size = size;
+
+		// Small heaps can become entirely cancelled before reaching the compaction threshold. Clear those immediately so `size` does not retain cancelled handles indefinitely:
+		if (timers->cancelled == heap->size && scheduled->size == 0) {
+			heap->size = 0;
+			timers->cancelled = 0;
+		} else {
+			IO_Event_Timers_heap_concat(heap, scheduled);
+		}
+	}
+
+	scheduled->size = 0;
+}
+
+// Remove the earliest entry from the heap, marking its handle as no longer retained.
+static inline void IO_Event_Timers_remove_first(struct IO_Event_Timers *timers, struct IO_Event_Timers_Handle *handle)
+{
+	IO_Event_Timers_heap_pop(&timers->heap);
+	handle->timers = Qnil;
+}
+
+// Schedule a block to be called at a specific time in the future.
+static VALUE IO_Event_Timers_schedule_time(VALUE self, double time, VALUE block)
+{
+	struct IO_Event_Timers *timers = IO_Event_Timers_get(self);
+
+	struct IO_Event_Timers_Handle *timer = NULL;
+	VALUE handle = TypedData_Make_Struct(IO_Event_NativeTimers_Handle, struct IO_Event_Timers_Handle, &IO_Event_Timers_Handle_Type, timer);
+
+	timer->time = time;
+	RB_OBJ_WRITE(handle, &timer->block, block);
+	timer->timers = Qnil;
+
+	IO_Event_Timers_Entries_reserve(&timers->scheduled, timers->scheduled.size + 1);
+
+	struct IO_Event_Timers_Entry *entry = timers->scheduled.base + timers->scheduled.size;
+	entry->time = time;
+	RB_OBJ_WRITE(self, &entry->handle, handle);
+	timers->scheduled.size += 1;
+
+	return handle;
+}
+
+static VALUE IO_Event_Timers_schedule(VALUE self, VALUE time, VALUE block)
+{
+	return IO_Event_Timers_schedule_time(self, NUM2DBL(time), block);
+}
+
+static VALUE IO_Event_Timers_after(VALUE self, VALUE offset)
+{
+	VALUE block = rb_block_given_p() ? rb_block_proc() : Qnil;
+	double time = IO_Event_Timers_current_time() + NUM2DBL(rb_funcall(offset, id_to_f, 0));
+
+	return IO_Event_Timers_schedule_time(self, time, block);
+}
+
+static VALUE IO_Event_Timers_size(VALUE self)
+{
+	struct IO_Event_Timers *timers = IO_Event_Timers_get(self);
+
+	IO_Event_Timers_flush(self, timers);
+
+	return SIZET2NUM(timers->heap.size);
+}
+
+static VALUE IO_Event_Timers_now(VALUE self)
+{
+	return DBL2NUM(IO_Event_Timers_current_time());
+}
+
+static VALUE IO_Event_Timers_wait_interval(int argc, VALUE *argv, VALUE self)
+{
+	VALUE _now = Qnil;
+	rb_scan_args(argc, argv, "01", &_now);
+
+	struct IO_Event_Timers *timers = IO_Event_Timers_get(self);
+	double now = NIL_P(_now) ? IO_Event_Timers_current_time() : NUM2DBL(_now);
+
+	IO_Event_Timers_flush(self, timers);
+
+	while (timers->heap.size > 0) {
+		struct IO_Event_Timers_Entry *entry = timers->heap.base;
+		struct IO_Event_Timers_Handle *handle = IO_Event_Timers_Handle_get(entry->handle);
+
+		if (IO_Event_Timers_Handle_cancelled_p(handle)) {
+			IO_Event_Timers_remove_first(timers, handle);
+			if (timers->cancelled > 0) timers->cancelled -= 1;
+		} else {
+			return DBL2NUM(entry->time - now);
+		}
+	}
+
+	return Qnil;
+}
+
+static VALUE IO_Event_Timers_fire(int argc, VALUE *argv, VALUE self)
+{
+	VALUE _now = Qnil;
+	rb_scan_args(argc, argv, "01", &_now);
+
+	struct IO_Event_Timers *timers = IO_Event_Timers_get(self);
+
+	if (NIL_P(_now)) {
+		_now = IO_Event_Timers_now(self);
+	}
+
+	double now = NUM2DBL(_now);
+
+	// Flush scheduled timers into the heap:
+	IO_Event_Timers_flush(self, timers);
+
+	// The heap may be modified by the blocks we invoke (e.g. a nested flush), so we always re-read the earliest entry:
+	while (timers->heap.size > 0) {
+		struct IO_Event_Timers_Entry entry = timers->heap.base[0];
+		struct IO_Event_Timers_Handle *handle = IO_Event_Timers_Handle_get(entry.handle);
+
+		if (IO_Event_Timers_Handle_cancelled_p(handle)) {
+			IO_Event_Timers_remove_first(timers, handle);
+			if (timers->cancelled > 0) timers->cancelled -= 1;
+		} else if (entry.time <= now) {
+			// Remove the earliest timer from the heap before calling the block, so the heap remains consistent if it raises:
+			IO_Event_Timers_remove_first(timers, handle);
+
+			rb_funcall(handle->block, id_call, 1, _now);
+
+			// The handle is no longer retained by the heap:
+			RB_GC_GUARD(entry.handle);
+		} else {
+			break;
+		}
+	}
+
+	return Qnil;
+}
+
+#pragma mark - Handle Methods
+
+static VALUE IO_Event_Timers_Handle_time(VALUE self)
+{
+	return DBL2NUM(IO_Event_Timers_Handle_get(self)->time);
+}
+
+static VALUE IO_Event_Timers_Handle_block(VALUE self)
+{
+	return IO_Event_Timers_Handle_get(self)->block;
+}
+
+static VALUE IO_Event_Timers_Handle_call(int argc, VALUE *argv, VALUE self)
+{
+	return rb_funcallv(IO_Event_Timers_Handle_get(self)->block, id_call, argc, argv);
+}
+
+static VALUE IO_Event_Timers_Handle_cancel(VALUE self)
+{
+	struct IO_Event_Timers_Handle *handle = IO_Event_Timers_Handle_get(self);
+
+	if (IO_Event_Timers_Handle_cancelled_p(handle)) return Qnil;
+
+	handle->block = Qnil;
+
+	// If the handle is retained in the heap, it will be removed lazily:
+	if (!NIL_P(handle->timers)) {
+		struct IO_Event_Timers *timers = IO_Event_Timers_get(handle->timers);
+		handle->timers = Qnil;
+
+		timers->cancelled += 1;
+	}
+
+	return Qnil;
+}
+
+static VALUE IO_Event_Timers_Handle_cancelled_p_method(VALUE self)
+{
+	return IO_Event_Timers_Handle_cancelled_p(IO_Event_Timers_Handle_get(self)) ? Qtrue : Qfalse;
+}
+
+void Init_IO_Event_Timers(VALUE IO_Event)
+{
+	id_call = rb_intern("call");
+	id_to_f = rb_intern("to_f");
+
+	IO_Event_NativeTimers = rb_define_class_under(IO_Event, "NativeTimers", rb_cObject);
+	rb_gc_register_mark_object(IO_Event_NativeTimers);
+
+	rb_define_alloc_func(IO_Event_NativeTimers, IO_Event_Timers_allocate);
+	rb_define_const(IO_Event_NativeTimers, "COMPACT_MINIMUM_COUNT", INT2NUM(IO_EVENT_TIMERS_COMPACT_MINIMUM_COUNT));
+
+	rb_define_method(IO_Event_NativeTimers, "size", IO_Event_Timers_size, 0);
+	rb_define_method(IO_Event_NativeTimers, "schedule", IO_Event_Timers_schedule, 2);
+	rb_define_method(IO_Event_NativeTimers, "after", IO_Event_Timers_after, 1);
+	rb_define_method(IO_Event_NativeTimers, "wait_interval", IO_Event_Timers_wait_interval, -1);
+	rb_define_method(IO_Event_NativeTimers, "now", IO_Event_Timers_now, 0);
+	rb_define_method(IO_Event_NativeTimers, "fire", IO_Event_Timers_fire, -1);
+
+	IO_Event_NativeTimers_Handle = rb_define_class_under(IO_Event_NativeTimers, "Handle", rb_cObject);
+	rb_gc_register_mark_object(IO_Event_NativeTimers_Handle);
+	rb_undef_alloc_func(IO_Event_NativeTimers_Handle);
+
+	rb_define_method(IO_Event_NativeTimers_Handle, "time", IO_Event_Timers_Handle_time, 0);
+	rb_define_method(IO_Event_NativeTimers_Handle, "block", IO_Event_Timers_Handle_block, 0);
+	rb_define_method(IO_Event_NativeTimers_Handle, "call", IO_Event_Timers_Handle_call, -1);
+	rb_define_method(IO_Event_NativeTimers_Handle, "cancel!", IO_Event_Timers_Handle_cancel, 0);
+	rb_define_method(IO_Event_NativeTimers_Handle, "cancelled?", IO_Event_Timers_Handle_cancelled_p_method, 0);
+}
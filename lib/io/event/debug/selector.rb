@@ -19,6 +19,186 @@ module IO::Event
 					log("Closing file descriptor #{descriptor}")
 					@selector.io_close(descriptor)
 				end
+				
+				# Register a ring of provided buffers, forwarded to the underlying selector.
+				#
+				# @parameter count [Integer] The number of buffers, which must be a power of two.
+				# @parameter size [Integer] The size of each buffer in bytes.
+				def provide_buffers(count, size)
+					log("Providing #{count} buffers of #{size} bytes")
+					@selector.provide_buffers(count, size)
+				end
+				
+				# Read into a buffer selected from the provided buffer ring, forwarded to the underlying selector.
+				def io_read_provided(fiber, io, &block)
+					log("Reading from IO #{io.inspect} into a provided buffer")
+					@selector.io_read_provided(fiber, io, &block)
+				end
+				
+				# Accept a connection using the listening socket's multishot accept, forwarded to the underlying selector.
+				#
+				# @parameter fiber [Fiber] The fiber which will wait for the connection.
+				# @parameter io [IO] The listening socket.
+				# @returns [Integer] The accepted file descriptor.
+				def io_accept(fiber, io)
+					log("Accepting connection on IO #{io.inspect}")
+					@selector.io_accept(fiber, io)
+				end
+				
+				# @returns [Boolean] Whether `io_wait` uses persistent multishot polls, forwarded to the underlying selector.
+				def multishot_poll
+					@selector.multishot_poll
+				end
+				
+				# Enable or disable persistent multishot polls for `io_wait`, forwarded to the underlying selector.
+				#
+				# @parameter value [Boolean] Whether to use multishot polls.
+				def multishot_poll=(value)
+					log("Setting multishot poll to #{value.inspect}")
+					@selector.multishot_poll = value
+				end
+				
+				# Register the IO in the fixed file table, forwarded to the underlying selector.
+				#
+				# @parameter io [IO] The IO to register.
+				# @returns [Boolean] Whether the IO was registered.
+				def register(io)
+					log("Registering IO #{io.inspect}")
+					@selector.register(io)
+				end
+				
+				# Remove the IO from the fixed file table, forwarded to the underlying selector.
+				#
+				# @parameter io [IO] The IO to unregister.
+				# @returns [Boolean] Whether the IO was registered.
+				def unregister(io)
+					log("Unregistering IO #{io.inspect}")
+					@selector.unregister(io)
+				end
+				
+				# @returns [Integer | Nil] The minimum size of writes which use zero-copy sends, forwarded to the underlying selector.
+				def zero_copy_threshold
+					@selector.zero_copy_threshold
+				end
+				
+				# Set the minimum size of writes which use zero-copy sends, forwarded to the underlying selector.
+				#
+				# @parameter value [Integer | Nil] The threshold in bytes, or nil to disable zero-copy sends.
+				def zero_copy_threshold=(value)
+					log("Setting zero-copy threshold to #{value.inspect}")
+					@selector.zero_copy_threshold = value
+				end
+				
+				# Read into the given buffers using a single vectored read, forwarded to the underlying selector.
+				def io_readv(fiber, io, buffers)
+					log("Reading from IO #{io.inspect} into #{buffers.size} buffers")
+					@selector.io_readv(fiber, io, buffers)
+				end
+				
+				# Write the given buffers using vectored writes, forwarded to the underlying selector.
+				def io_writev(fiber, io, buffers)
+					log("Writing to IO #{io.inspect} from #{buffers.size} buffers")
+					@selector.io_writev(fiber, io, buffers)
+				end
+				
+				# Transfer data from one IO to another without copying it through user space, forwarded to the underlying selector.
+				def io_splice(fiber, from, to, length)
+					log("Splicing #{length} bytes from IO #{from.inspect} to IO #{to.inspect}")
+					@selector.io_splice(fiber, from, to, length)
+				end
+				
+				# Read from the given position in the file, forwarded to the underlying selector.
+				def io_pread(fiber, io, buffer, from, length, offset = 0)
+					log("Reading from IO #{io.inspect} at position #{from} with buffer #{buffer}; length #{length} offset #{offset}")
+					@selector.io_pread(fiber, io, buffer, from, length, offset)
+				end
+				
+				# Write to the given position in the file, forwarded to the underlying selector.
+				def io_pwrite(fiber, io, buffer, from, length, offset = 0)
+					log("Writing to IO #{io.inspect} at position #{from} with buffer #{buffer}; length #{length} offset #{offset}")
+					@selector.io_pwrite(fiber, io, buffer, from, length, offset)
+				end
+				
+				# Open the file at the given path, forwarded to the underlying selector.
+				def io_open(fiber, path, flags, mode)
+					log("Opening file #{path.inspect} with flags #{flags} and mode #{mode}")
+					@selector.io_open(fiber, path, flags, mode)
+				end
+				
+				# Get the status of the file at the given path, forwarded to the underlying selector.
+				def io_stat(fiber, path)
+					log("Getting status of file #{path.inspect}")
+					@selector.io_stat(fiber, path)
+				end
+				
+				# Flush the file to the storage device, forwarded to the underlying selector.
+				def io_fsync(fiber, io, *arguments)
+					log("Synchronizing IO #{io.inspect}")
+					@selector.io_fsync(fiber, io, *arguments)
+				end
+				
+				# Allocate disk space for the given region of the file, forwarded to the underlying selector.
+				def io_fallocate(fiber, io, offset, length)
+					log("Allocating #{length} bytes at offset #{offset} for IO #{io.inspect}")
+					@selector.io_fallocate(fiber, io, offset, length)
+				end
+				
+				# @returns [Boolean] Whether new registrations use edge-triggered mode, forwarded to the underlying selector.
+				def edge_triggered
+					@selector.edge_triggered
+				end
+				
+				# Enable or disable edge-triggered registrations, forwarded to the underlying selector.
+				#
+				# @parameter value [Boolean] Whether to use edge-triggered mode.
+				def edge_triggered=(value)
+					log("Setting edge triggered to #{value.inspect}")
+					@selector.edge_triggered = value
+				end
+				
+				# @returns [Float] How long the selector polls for events before blocking, forwarded to the underlying selector.
+				def spin
+					@selector.spin
+				end
+				
+				# Set how long the selector polls for events before blocking, forwarded to the underlying selector.
+				#
+				# @parameter value [Numeric | Nil] The spin budget in seconds, or nil to block immediately.
+				def spin=(value)
+					log("Setting spin to #{value.inspect}")
+					@selector.spin = value
+				end
+				
+				# @returns [Boolean] Whether scheduling latency is recorded, forwarded to the underlying selector.
+				def latency_tracking
+					@selector.latency_tracking
+				end
+				
+				# Enable or disable recording scheduling latency, forwarded to the underlying selector.
+				#
+				# @parameter value [Boolean] Whether to record scheduling latency.
+				def latency_tracking=(value)
+					log("Setting latency tracking to #{value.inspect}")
+					@selector.latency_tracking = value
+				end
+				
+				# @returns [Array(Integer) | Nil] The log2 histogram of scheduling latency in nanoseconds, forwarded to the underlying selector.
+				def latency_histogram
+					@selector.latency_histogram
+				end
+				
+				# @returns [Boolean] Whether reads and writes are first attempted directly, forwarded to the underlying selector.
+				def optimistic_io
+					@selector.optimistic_io
+				end
+				
+				# Enable or disable optimistic reads and writes, forwarded to the underlying selector.
+				#
+				# @parameter value [Boolean] Whether to try reads and writes directly before submitting them.
+				def optimistic_io=(value)
+					log("Setting optimistic IO to #{value.inspect}")
+					@selector.optimistic_io = value
+				end
 			end
 			
 			# Wrap the given selector with debugging.
@@ -74,6 +254,13 @@ module IO::Event
 				@selector.idle_duration
 			end
 			
+			# Runtime statistics of the underlying selector.
+			#
+			# @returns [Hash] The statistics.
+			def statistics
+				@selector.statistics
+			end
+			
 			# The current time.
 			#
 			# @returns [Numeric] The current time.
@@ -142,6 +329,14 @@ module IO::Event
 				@selector.push(fiber)
 			end
 			
+			# Push the given fiber to the selector ready list from any thread, waking up the event loop if it is blocked.
+			#
+			# @parameter fiber [Fiber] The fiber that is ready.
+			def push_remote(fiber)
+				log("Pushing fiber #{fiber.inspect} to ready list from another thread")
+				@selector.push_remote(fiber)
+			end
+			
 			# Raise the given exception on the given fiber.
 			#
 			# @parameter fiber [Fiber] The fiber to raise the exception on.
@@ -171,21 +366,21 @@ module IO::Event
 			end
 			
 			# Wait for the given IO, forwarded to the underlying selector.
-			def io_wait(fiber, io, events)
+			def io_wait(fiber, io, events, *arguments)
 				log("Waiting for IO #{io.inspect} for events #{events.inspect}")
-				@selector.io_wait(fiber, io, events)
+				@selector.io_wait(fiber, io, events, *arguments)
 			end
 			
 			# Read from the given IO, forwarded to the underlying selector.
-			def io_read(fiber, io, buffer, length, offset = 0)
+			def io_read(fiber, io, buffer, length, offset = 0, *arguments)
 				log("Reading from IO #{io.inspect} with buffer #{buffer}; length #{length} offset #{offset}")
-				@selector.io_read(fiber, io, buffer, length, offset)
+				@selector.io_read(fiber, io, buffer, length, offset, *arguments)
 			end
 			
 			# Write to the given IO, forwarded to the underlying selector.
-			def io_write(fiber, io, buffer, length, offset = 0)
+			def io_write(fiber, io, buffer, length, offset = 0, *arguments)
 				log("Writing to IO #{io.inspect} with buffer #{buffer}; length #{length} offset #{offset}")
-				@selector.io_write(fiber, io, buffer, length, offset)
+				@selector.io_write(fiber, io, buffer, length, offset, *arguments)
 			end
 			
 			# Forward the given method to the underlying selector.
@@ -26,13 +26,50 @@ module IO::Event
 			end
 		end
 		
+		# Options for the given selector implementation, read from the environment.
+		#
+		# - `IO_EVENT_SELECTOR_URING_ENTRIES`: The size of the `URing` submission queue.
+		# - `IO_EVENT_SELECTOR_URING_SQPOLL`: If set, `URing` uses a kernel thread to poll the submission queue.
+		# - `IO_EVENT_SELECTOR_URING_SQ_THREAD_CPU`: The CPU to pin the submission queue polling thread to.
+		# - `IO_EVENT_SELECTOR_EPOLL_MAX_EVENTS`: The initial number of events returned by each `epoll_wait` call.
+		#
+		# @parameter klass [Class] The selector implementation.
+		# @parameter env [Hash] The environment to read configuration from.
+		# @returns [Hash] The keyword arguments to pass to the selector's constructor.
+		def self.options(klass, env = ENV)
+			options = {}
+			
+			if defined?(URing) and klass == URing
+				if entries = env["IO_EVENT_SELECTOR_URING_ENTRIES"]
+					options[:entries] = Integer(entries)
+				end
+				
+				if env["IO_EVENT_SELECTOR_URING_SQPOLL"]
+					options[:sqpoll] = true
+					
+					if sq_thread_cpu = env["IO_EVENT_SELECTOR_URING_SQ_THREAD_CPU"]
+						options[:sq_thread_cpu] = Integer(sq_thread_cpu)
+					end
+				end
+			end
+			
+			if defined?(EPoll) and klass == EPoll
+				if max_events = env["IO_EVENT_SELECTOR_EPOLL_MAX_EVENTS"]
+					options[:max_events] = Integer(max_events)
+				end
+			end
+			
+			return options
+		end
+		
 		# Create a new selector instance, according to the best available implementation.
 		#
 		# @parameter loop [Fiber] The event loop fiber.
 		# @parameter env [Hash] The environment to read configuration from.
 		# @returns [Selector] The new selector instance.
 		def self.new(loop, env = ENV)
-			selector = default(env).new(loop)
+			klass = default(env)
+			selector = klass.new(loop, **options(klass, env))
 			
 			if debug = env["IO_EVENT_DEBUG_SELECTOR"]
 				selector = Debug::Selector.wrap(selector, env)
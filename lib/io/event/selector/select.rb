@@ -22,10 +22,24 @@ module IO::Event
 				# Used by wakeup() to determine if an interrupt signal is needed.
 				@blocked = false
 				
+				# Whether a fiber was pushed from another thread since the event loop last checked the ready list, in which case further pushes don't need to wake it up.
+				@remote = false
+				
 				@ready = Queue.new
 				@interrupt = Interrupt.attach(self)
 				
 				@idle_duration = 0.0
+				
+				@statistics = {
+					selects: 0,
+					blocking_waits: 0,
+					events: 0,
+					ready_flushes: 0,
+					ready_resumes: 0,
+					wakeups: 0,
+					wakeup_signals: 0,
+					cancellations: 0,
+				}
 			end
 			
 			# @attribute [Fiber] The event loop fiber.
@@ -34,9 +48,19 @@ module IO::Event
 			# @attribute [Float] This is the amount of time the event loop was idle during the last select call.
 			attr :idle_duration
 			
+			# Runtime statistics of the selector, e.g. the number of calls to `select` and how many of them blocked.
+			#
+			# @returns [Hash] The statistics.
+			def statistics
+				@statistics.dup
+			end
+			
 			# Wake up the event loop if it is currently sleeping.
 			def wakeup
+				@statistics[:wakeups] += 1
+				
 				if @blocked
+					@statistics[:wakeup_signals] += 1
 					@interrupt.signal
 					
 					return true
@@ -106,6 +130,18 @@ module IO::Event
 				@ready.push(fiber)
 			end
 			
+			# Append the given fiber into the ready list from any thread, waking up the event loop if it is blocked, once for all the fibers pushed before it runs again. The ready list is a thread-safe queue, so no additional synchronization is required.
+			def push_remote(fiber)
+				@ready.push(fiber)
+				
+				unless @remote
+					@remote = true
+					wakeup
+				end
+				
+				return nil
+			end
+			
 			# Transfer to the given fiber and raise an exception. Put the current fiber into the ready list.
 			def raise(fiber, *arguments, **options)
 				optional = Optional.new(Fiber.current)
@@ -175,7 +211,11 @@ module IO::Event
 				
 				@loop.transfer || false
 			ensure
-				waiter&.invalidate
+				if waiter
+					# The waiter is only cleared when it is dispatched, so if it's still set, the wait was cancelled:
+					@statistics[:cancellations] += 1 if waiter.fiber
+					waiter.invalidate
+				end
 			end
 			
 			# Wait for multiple IO objects to become readable or writable.
@@ -271,6 +311,47 @@ module IO::Event
 				return total
 			end
 			
+			# Read into the given buffers, in order. Only the first read waits for the IO to become readable, subsequent buffers are only filled with data which is already available.
+			#
+			# @parameter buffers [Array(IO::Buffer)] The buffers to read into.
+			# @returns [Integer] The total number of bytes read, or a negative errno.
+			def io_readv(fiber, io, buffers)
+				total = 0
+				
+				buffers.each do |buffer|
+					next if buffer.size.zero?
+					
+					result = io_read(fiber, io, buffer, total.zero? ? 1 : 0)
+					
+					if result < 0
+						return total.zero? ? result : total
+					end
+					
+					total += result
+					break if result < buffer.size
+				end
+				
+				return total
+			end
+			
+			# Write all of the given buffers, in order.
+			#
+			# @parameter buffers [Array(IO::Buffer)] The buffers to write.
+			# @returns [Integer] The total number of bytes written, or a negative errno.
+			def io_writev(fiber, io, buffers)
+				total = 0
+				
+				buffers.each do |buffer|
+					result = io_write(fiber, io, buffer, buffer.size)
+					return result if result < 0
+					
+					total += result
+					break if result < buffer.size
+				end
+				
+				return total
+			end
+			
 			# Wait for a process to change state.
 			#
 			# @parameter fiber [Fiber] The fiber to resume after waiting.
@@ -285,6 +366,9 @@ module IO::Event
 				unless @ready.empty?
 					count = @ready.size
 					
+					@statistics[:ready_flushes] += 1
+					@statistics[:ready_resumes] += count
+					
 					count.times do
 						fiber = @ready.pop
 						fiber.transfer if fiber.alive?
@@ -299,6 +383,8 @@ module IO::Event
 			# @parameter duration [Numeric | Nil] The maximum time to wait, or nil for no timeout.
 			# @returns [Integer] The number of ready IO objects.
 			def select(duration = nil)
+				@statistics[:selects] += 1
+				
 				if pop_ready
 					# If we have popped items from the ready list, they may influence the duration calculation, so we don't delay the event loop:
 					duration = 0
@@ -334,6 +420,10 @@ module IO::Event
 				duration = 0 unless @ready.empty?
 				error = nil
 				
+				if duration.nil? or duration > 0
+					@statistics[:blocking_waits] += 1
+				end
+				
 				if duration&.>(0)
 					start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
 				else
@@ -342,7 +432,12 @@ module IO::Event
 				
 				# We need to handle interrupts on blocking IO. Every other implementation uses EINTR, but that doesn't work with `::IO.select` as it will retry the call on EINTR.
 				Thread.handle_interrupt(::Exception => :on_blocking) do
+					@remote = false
 					@blocked = true
+					
+					# A fiber pushed from another thread before we were blocked won't have woken us up:
+					duration = 0 unless @ready.empty?
+					
 					readable, writable, priority = ::IO.select(readable, writable, priority, duration)
 				rescue ::Exception => error
 					# Requeue below...
@@ -381,6 +476,8 @@ module IO::Event
 					ready[io] |= IO::PRIORITY unless io.closed?
 				end
 				
+				@statistics[:events] += ready.size
+				
 				ready.each do |io, events|
 					@waiting.delete(io).dispatch(events) do |waiter|
 						# Re-schedule the waiting IO:
@@ -4,10 +4,13 @@
 # Copyright, 2024-2026, by Samuel Williams.
 
 require_relative "priority_heap"
+require_relative "timing_wheel"
 
 class IO
 	module Event
 		# An efficient sorted set of timers.
+		#
+		# By default, all timers are stored in a {PriorityHeap}. If a `resolution` is given, timers due within the horizon of a {TimingWheel} are stored there instead, making scheduling and cancellation `O(1)`, while far-future timers fall back to the heap. This suits workloads dominated by I/O timeouts which are usually cancelled before they fire.
 		class Timers
 			COMPACT_MINIMUM_COUNT = 128
 			
@@ -79,17 +82,29 @@ class IO
 			end
 			
 			# Initialize the timers.
-			def initialize
+			#
+			# @parameter resolution [Float | Nil] If specified, the tick duration of a {TimingWheel} used for near-future timers.
+			def initialize(resolution: nil)
 				@heap = PriorityHeap.new
 				@scheduled = []
 				@cancelled = 0
+				
+				if resolution
+					@wheel = TimingWheel.new(resolution, self.now)
+				else
+					@wheel = nil
+				end
 			end
 			
-			# @returns [Integer] The number of timers in the heap.
+			# @returns [Integer] The number of timers in the heap and timing wheel.
 			def size
 				flush!
 				
-				return @heap.size
+				if @wheel
+					return @heap.size + @wheel.size
+				else
+					return @heap.size
+				end
 			end
 			
 			# Schedule a block to be called at a specific time in the future.
@@ -119,15 +134,20 @@ class IO
 			def wait_interval(now = self.now)
 				flush!
 				
+				time = @wheel&.next_time
+				
 				while handle = @heap.peek
 					if handle.cancelled?
 						@heap.pop
 						handle.removed!
 						@cancelled -= 1 if @cancelled > 0
 					else
-						return handle.time - now
+						time = handle.time if time.nil? || handle.time < time
+						break
 					end
 				end
+				
+				return time - now if time
 			end
 			
 			# @returns [Float] The current time.
@@ -142,6 +162,8 @@ class IO
 				# Flush scheduled timers into the heap:
 				flush!
 				
+				return fire_wheel(now) if @wheel
+				
 				# Get the earliest timer:
 				while handle = @heap.peek
 					if handle.cancelled?
@@ -161,10 +183,57 @@ class IO
 				end
 			end
 			
+			# Fire all due timers from both the timing wheel and the heap, in time order.
+			#
+			# @parameter now [Float] The current time.
+			private def fire_wheel(now)
+				due = @wheel.expire(now)
+				
+				while handle = @heap.peek
+					if handle.cancelled?
+						@heap.pop
+						handle.removed!
+						@cancelled -= 1 if @cancelled > 0
+					elsif handle.time <= now
+						@heap.pop
+						handle.removed!
+						due << handle
+					else
+						break
+					end
+				end
+				
+				due.sort_by!(&:time)
+				index = 0
+				
+				begin
+					while handle = due[index]
+						index += 1
+						
+						# An earlier block may have cancelled this timer:
+						handle.call(now) unless handle.cancelled?
+					end
+				ensure
+					# If a block raised an exception, reschedule the timers which have not fired yet:
+					if index < due.size
+						@scheduled.concat(due[index..])
+					end
+				end
+				
+				return nil
+			end
+			
 			# Flush all scheduled timers into the heap.
 			#
 			# Scheduling appends to `@scheduled` and cancellation is `O(1)`. We pay the cost of filtering and heap repair here, where we can batch work and choose between incremental insertion and one `heapify` pass.
 			protected def flush!
+				# Timers within the horizon of the timing wheel are inserted in `O(1)` and never enter the heap:
+				if @wheel
+					@scheduled.delete_if do |handle|
+						handle.cancelled? || @wheel.insert(handle)
+					end
+				end
+				
 				# Once cancelled handles are both numerous and a large fraction of the heap, rebuild the heap. This is `O(n + m)`, but it removes retained cancelled handles and appends live scheduled handles in the same `heapify` pass instead of paying for separate filtering and insertion.
 				if @cancelled >= COMPACT_MINIMUM_COUNT && @cancelled * 2 > @heap.size
 					@heap.heapify do |contents|
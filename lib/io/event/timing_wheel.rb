@@ -0,0 +1,181 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+class IO
+	module Event
+		# A hashed timing wheel for timers which are due within a bounded horizon.
+		#
+		# Time is divided into ticks of `resolution` seconds, and each tick maps onto one of a fixed number of slots. Inserting and cancelling a timer is `O(1)`, and advancing the wheel only visits the slots between the previous and current tick. Timers beyond the horizon (`resolution * slots` seconds from the current tick) are rejected by {#insert} and should be stored elsewhere, e.g. in a {PriorityHeap}.
+		#
+		# Stored handles must respond to `time`, `cancelled?`, `schedule!(owner)` and `removed!`. Cancelled handles must notify the wheel by calling {#cancelled!}, after which they are released lazily.
+		class TimingWheel
+			SLOTS = 1024
+			
+			COMPACT_MINIMUM_COUNT = 128
+			
+			# Initialize the timing wheel.
+			#
+			# @parameter resolution [Float] The duration of each tick, in seconds.
+			# @parameter now [Float] The current time, which determines the initial tick.
+			# @parameter slots [Integer] The number of slots, which determines the horizon.
+			def initialize(resolution, now, slots: SLOTS)
+				raise ArgumentError, "Resolution must be positive!" unless resolution.positive?
+				
+				@resolution = resolution
+				@slots = Array.new(slots){Array.new}
+				@count = slots
+				@tick = tick_for(now)
+				
+				# No live handles are stored in a tick before the cursor, so {#next_time} can start scanning from here:
+				@cursor = @tick
+				
+				# The number of live handles in the wheel:
+				@size = 0
+				
+				# The number of cancelled handles still retained in the slots:
+				@cancelled = 0
+			end
+			
+			# @attribute [Float] The duration of each tick, in seconds.
+			attr :resolution
+			
+			# @attribute [Integer] The number of live handles in the wheel.
+			attr :size
+			
+			# @returns [Float] The maximum distance from the current tick at which handles can be inserted.
+			def horizon
+				@resolution * @slots.size
+			end
+			
+			# @returns [Boolean] Whether the wheel contains any live handles.
+			def empty?
+				@size.zero?
+			end
+			
+			# Insert the handle into the wheel, if its time is within the horizon.
+			#
+			# @parameter handle [Object] The handle to insert.
+			# @returns [Boolean] Whether the handle was inserted.
+			def insert(handle)
+				tick = (handle.time / @resolution).floor
+				
+				# Handles beyond the horizon can't be stored without aliasing a nearer slot:
+				return false if tick - @tick >= @count
+				
+				# Handles which are already due are stored in the current slot:
+				tick = @tick if tick < @tick
+				
+				@slots[tick % @count] << handle
+				@cursor = tick if tick < @cursor
+				handle.schedule!(self)
+				@size += 1
+				
+				return true
+			end
+			
+			# Track a cancelled handle which is still retained in a slot.
+			#
+			# @parameter handle [Object] The cancelled handle.
+			def cancelled!(handle)
+				@size -= 1
+				@cancelled += 1
+				
+				# Handles are normally released when their slot expires. If timers are cancelled faster than time advances, release them early so the slots don't grow without bound:
+				if @cancelled >= COMPACT_MINIMUM_COUNT && @cancelled > @size
+					compact!
+				end
+			end
+			
+			# Remove all cancelled handles from the slots.
+			def compact!
+				@slots.each do |slot|
+					slot.delete_if(&:cancelled?)
+				end
+				
+				@cancelled = 0
+			end
+			
+			# Compute the time of the earliest live handle. This only scans slots up to the first one containing a live handle, and remembers where it stopped so repeated calls are cheap.
+			#
+			# @returns [Float | Nil] The earliest time, or nil if the wheel is empty.
+			def next_time
+				return nil if @size.zero?
+				
+				@cursor = @tick if @cursor < @tick
+				
+				while @cursor < @tick + @slots.size
+					slot = @slots[@cursor % @slots.size]
+					time = nil
+					
+					slot.each do |handle|
+						next if handle.cancelled?
+						
+						time = handle.time if time.nil? || handle.time < time
+					end
+					
+					return time if time
+					
+					@cursor += 1
+				end
+				
+				return nil
+			end
+			
+			# Advance the wheel to the given time, removing all handles which are due.
+			#
+			# @parameter now [Float] The current time.
+			# @parameter due [Array] The array to which due handles are appended, in no particular order.
+			# @returns [Array] The due handles.
+			def expire(now, due = Array.new)
+				target = tick_for(now)
+				
+				if @size.zero?
+					# Only cancelled handles remain, so we can release them all at once:
+					compact! if @cancelled > 0
+				else
+					# Visit each slot at most once, even if time has advanced beyond the horizon. The current slot is always visited, since overdue handles are stored there and may be due even if `now` is before the current tick:
+					last = [[target, @tick].max, @tick + @slots.size - 1].min
+					carry = nil
+					
+					@tick.upto(last) do |tick|
+						slot = @slots[tick % @slots.size]
+						next if slot.empty?
+						
+						slot.delete_if do |handle|
+							if handle.cancelled?
+								@cancelled -= 1 if @cancelled > 0
+								true
+							elsif handle.time <= now
+								handle.removed!
+								@size -= 1
+								due << handle
+								true
+							end
+						end
+						
+						# Handles left in a slot we are moving past (e.g. due to rounding) must move to the new current slot, otherwise they would be aliased into a future tick:
+						if tick < target and !slot.empty?
+							carry ||= Array.new
+							carry.concat(slot)
+							slot.clear
+						end
+					end
+					
+					if carry
+						@slots[target % @slots.size].concat(carry)
+					end
+				end
+				
+				@tick = target if target > @tick
+				
+				return due
+			end
+			
+			private def tick_for(time)
+				(time / @resolution).floor
+			end
+		end
+	end
+end
@@ -119,6 +119,47 @@ Selector = Sus::Shared("a selector") do
 		end
 	end
 	
+	with "#push_remote" do
+		it "wakes up the selector and resumes the fiber" do
+			fiber = FakeFiber.new
+			
+			10.times do |i|
+				thread = Thread.new do
+					sleep(i / 10000.0)
+					selector.push_remote(fiber)
+				end
+				
+				expect do
+					selector.select(1.0)
+					selector.select(0) until fiber.count > i
+				end.to have_duration(be < 1.0)
+			ensure
+				thread.join
+			end
+			
+			expect(fiber.count).to be == 10
+		end
+		
+		it "resumes fibers in the order they were pushed" do
+			order = []
+			fibers = 3.times.map do |index|
+				Fiber.new do
+					order << index
+					loop.transfer
+				end
+			end
+			
+			Thread.new do
+				fibers.each{|fiber| selector.push_remote(fiber)}
+			end.join
+			
+			expect(selector).to be(:ready?)
+			selector.select(0)
+			
+			expect(order).to be == [0, 1, 2]
+		end
+	end
+	
 	with "#io_wait" do
 		let(:events) {Array.new}
 		let(:sockets) {UNIXSocket.pair}
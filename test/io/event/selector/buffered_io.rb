@@ -7,6 +7,7 @@
 require "io/event"
 require "io/event/selector"
 require "socket"
+require "io/nonblock"
 
 require "unix_socket"
 
@@ -173,6 +174,132 @@ BufferedIO = Sus::Shared("buffered io") do
 			writer.transfer
 			selector.select(0)
 		end
+		
+		it "restores blocking mode after each read" do
+			skip_if_ruby_platform(/mswin|mingw|cygwin/)
+			
+			input.nonblock = false
+			output.write("HelloWorld")
+			
+			2.times do
+				buffer = IO::Buffer.new(5)
+				expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+				expect(input).not.to be(:nonblock?)
+			end
+		end
+		
+		it "can read from a reused descriptor" do
+			skip_if_ruby_platform(/mswin|mingw|cygwin/)
+			
+			input.nonblock = true
+			output.write("Hello")
+			buffer = IO::Buffer.new(5)
+			expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			
+			descriptor = input.fileno
+			input.close
+			
+			# The new pipe reuses the descriptor, but starts off in blocking mode:
+			IO.pipe do |reused_input, reused_output|
+				expect(reused_input.fileno).to be == descriptor
+				reused_input.nonblock = false
+				
+				reader = Fiber.new do
+					expect(selector.io_read(Fiber.current, reused_input, buffer, 5, 0)).to be == 5
+				end
+				
+				# The reader is waiting, which it can only do if the descriptor was made non-blocking:
+				reader.transfer
+				expect(reused_input).to be(:nonblock?)
+				
+				reused_output.write("World")
+				selector.select(1)
+				
+				expect(reader).not.to be(:alive?)
+				expect(reused_input).not.to be(:nonblock?)
+			end
+		end
+		
+		it "can wait after the descriptor is made blocking" do
+			skip_if_ruby_platform(/mswin|mingw|cygwin/)
+			
+			input.nonblock = true
+			output.write("Hello")
+			buffer = IO::Buffer.new(5)
+			expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			
+			input.nonblock = false
+			
+			reader = Fiber.new do
+				expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			end
+			
+			# The reader is waiting, rather than blocking the event loop:
+			reader.transfer
+			expect(reader).to be(:alive?)
+			
+			output.write("World")
+			selector.select(1)
+			
+			expect(reader).not.to be(:alive?)
+			expect(input).not.to be(:nonblock?)
+		end
+	end
+	
+	with "a socket pair" do
+		let(:sockets) {UNIXSocket.pair}
+		let(:input) {sockets.first}
+		let(:output) {sockets.last}
+		
+		after do
+			sockets.each(&:close)
+		end
+		
+		it "can wait after the descriptor is made blocking" do
+			skip_if_ruby_platform(/mswin|mingw|cygwin/)
+			
+			output.write("Hello")
+			buffer = IO::Buffer.new(5)
+			expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			
+			input.nonblock = false
+			
+			reader = Fiber.new do
+				expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			end
+			
+			# The reader is waiting, rather than blocking the event loop:
+			reader.transfer
+			expect(reader).to be(:alive?)
+			
+			output.write("World")
+			selector.select(1)
+			
+			expect(reader).not.to be(:alive?)
+			expect(input).not.to be(:nonblock?)
+		end
+		
+		it "can write and read using buffers" do
+			skip_if_ruby_platform(/mswin|mingw|cygwin/)
+			
+			writer = Fiber.new do
+				buffer = IO::Buffer.for("Hello World")
+				expect(selector.io_write(Fiber.current, output, buffer, 11, 0)).to be == 11
+			end
+			
+			reader = Fiber.new do
+				buffer = IO::Buffer.new(11)
+				expect(selector.io_read(Fiber.current, input, buffer, 11, 0)).to be == 11
+				expect(buffer.get_string).to be == "Hello World"
+			end
+			
+			reader.transfer
+			writer.transfer
+			
+			selector.select(1)
+			
+			expect(reader).not.to be(:alive?)
+		end
 	end
 end
 
@@ -0,0 +1,230 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+EdgeTriggered = Sus::Shared("edge triggered") do
+	before do
+		selector.edge_triggered = true
+	end
+	
+	def run_until_finished(*fibers)
+		fibers.each(&:transfer)
+		
+		while fibers.any?(&:alive?)
+			selector.select(1)
+		end
+	end
+	
+	it "can enable and disable edge-triggered mode" do
+		expect(selector.edge_triggered).to be == true
+		
+		selector.edge_triggered = false
+		expect(selector.edge_triggered).to be == false
+	end
+	
+	it "can wait for readable and writable events" do
+		local, remote = UNIXSocket.pair
+		events = []
+		
+		run_until_finished(Fiber.new do
+			events << selector.io_wait(Fiber.current, local, IO::WRITABLE)
+			
+			remote.write("Hello")
+			events << selector.io_wait(Fiber.current, local, IO::READABLE)
+			expect(local.read_nonblock(5)).to be == "Hello"
+			
+			remote.write("World")
+			events << selector.io_wait(Fiber.current, local, IO::READABLE)
+			expect(local.read_nonblock(5)).to be == "World"
+		end)
+		
+		expect(events).to be == [IO::WRITABLE, IO::READABLE, IO::READABLE]
+	ensure
+		local&.close
+		remote&.close
+	end
+	
+	it "caches readiness which no fiber was waiting for" do
+		local, remote = UNIXSocket.pair
+		
+		# Register the descriptor:
+		run_until_finished(Fiber.new do
+			selector.io_wait(Fiber.current, local, IO::WRITABLE)
+		end)
+		
+		remote.write("Hello")
+		selector.select(0)
+		
+		# The readiness was reported while nothing was waiting, so it is returned without waiting:
+		expect(selector.io_wait(Fiber.current, local, IO::READABLE)).to be == IO::READABLE
+		expect(local.read_nonblock(5)).to be == "Hello"
+	ensure
+		local&.close
+		remote&.close
+	end
+	
+	it "keeps reporting hang ups" do
+		local, remote = UNIXSocket.pair
+		
+		run_until_finished(Fiber.new do
+			selector.io_wait(Fiber.current, local, IO::WRITABLE)
+		end)
+		
+		remote.close
+		selector.select(0)
+		
+		2.times do
+			expect(selector.io_wait(Fiber.current, local, IO::READABLE)).to be == IO::READABLE
+		end
+	ensure
+		local&.close
+		remote&.close
+	end
+	
+	it "can wait again after nothing was waiting" do
+		local, remote = UNIXSocket.pair
+		
+		2.times do
+			remote.write("Hello")
+			
+			run_until_finished(Fiber.new do
+				expect(selector.io_wait(Fiber.current, local, IO::READABLE)).to be == IO::READABLE
+				expect(local.read_nonblock(5)).to be == "Hello"
+			end)
+		end
+	ensure
+		local&.close
+		remote&.close
+	end
+	
+	it "releases IOs which are no longer waited on" do
+		references = ObjectSpace::WeakMap.new
+		
+		10.times do
+			input, output = IO.pipe
+			references[input] = true
+			
+			run_until_finished(Fiber.new do
+				output.write("Hello")
+				selector.io_wait(Fiber.current, input, IO::READABLE)
+			end)
+			
+			output.close
+		end
+		
+		GC.start
+		
+		expect(references.keys.size).to be < 10
+	end
+	
+	it "caches hang ups in level-triggered mode" do
+		selector.edge_triggered = false
+		local, remote = UNIXSocket.pair
+		remote.close
+		
+		run_until_finished(Fiber.new do
+			expect(selector.io_wait(Fiber.current, local, IO::WRITABLE)).to be == IO::WRITABLE
+		end)
+		
+		# The hang up was reported along with the writable event, so waiting for readable doesn't need to wait:
+		expect(selector.io_wait(Fiber.current, local, IO::READABLE)).to be == IO::READABLE
+	ensure
+		local&.close
+	end
+	
+	# A datagram socket connected to a port which nobody is listening on, which reports an error once a datagram has been sent:
+	def refused_socket
+		server = UDPSocket.new
+		server.bind("127.0.0.1", 0)
+		port = server.addr[1]
+		server.close
+		
+		socket = UDPSocket.new
+		socket.connect("127.0.0.1", port)
+		socket.send("Hello", 0)
+		
+		return socket
+	end
+	
+	[true, false].each do |edge_triggered|
+		it "consumes errors (edge_triggered: #{edge_triggered})" do
+			selector.edge_triggered = edge_triggered
+			socket = refused_socket
+			
+			run_until_finished(Fiber.new do
+				expect(selector.io_wait(Fiber.current, socket, IO::READABLE)).to be == IO::READABLE
+			end)
+			
+			expect do
+				socket.recv_nonblock(5)
+			end.to raise_exception(Errno::ECONNREFUSED)
+			
+			# The error was consumed, so waiting again must wait for the kernel:
+			waiter = Fiber.new do
+				selector.io_wait(Fiber.current, socket, IO::READABLE)
+			end
+			
+			waiter.transfer
+			selector.select(0)
+			
+			expect(waiter).to be(:alive?)
+		ensure
+			socket&.close
+		end
+	end
+	
+	it "can read and write using the selector" do
+		local, remote = UNIXSocket.pair
+		received = []
+		
+		run_until_finished(
+			Fiber.new do
+				buffer = IO::Buffer.new(5)
+				
+				3.times do
+					selector.io_read(Fiber.current, local, buffer, 5)
+					received << buffer.get_string
+				end
+			end,
+			Fiber.new do
+				3.times do
+					selector.io_write(Fiber.current, remote, IO::Buffer.for("Hello"), 5)
+					selector.yield
+				end
+			end
+		)
+		
+		expect(received).to be == ["Hello"] * 3
+	ensure
+		local&.close
+		remote&.close
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Edge-triggered registration is currently only implemented by `EPoll`:
+	next unless klass.method_defined?(:edge_triggered=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like EdgeTriggered
+	end
+end
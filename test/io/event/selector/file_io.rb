@@ -79,6 +79,23 @@ FileIO = Sus::Shared("file io") do
 			expect(read_result).to be == 64
 		end
 		
+		it "can pread and pwrite at the given position" do
+			skip "io_pread is not implemented" unless selector.respond_to?(:io_pread)
+			
+			buffer = IO::Buffer.for(+"Hello World").dup
+			expect(selector.io_pwrite(Fiber.current, file, buffer, 5, buffer.size, 0)).to be == 11
+			
+			# The file position is not changed:
+			expect(file.pos).to be == 0
+			
+			buffer = IO::Buffer.new(5)
+			expect(selector.io_pread(Fiber.current, file, buffer, 11, 5, 0)).to be == 5
+			expect(buffer.get_string).to be == "World"
+			
+			# Reading past the end of the file returns zero:
+			expect(selector.io_pread(Fiber.current, file, buffer, 16, 1, 0)).to be == 0
+		end
+		
 		it "can wait for the file to become writable" do
 			wait_result = nil
 			
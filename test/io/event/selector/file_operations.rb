@@ -0,0 +1,126 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "tempfile"
+require "tmpdir"
+
+FileOperations = Sus::Shared("file operations") do
+	let(:file) {Tempfile.new}
+	
+	after do
+		file.close!
+	end
+	
+	# Run the given block on a fiber, driving the selector until it completes.
+	def run
+		result = nil
+		
+		fiber = Fiber.new do
+			result = yield
+		end
+		
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+		
+		return result
+	end
+	
+	it "can open a file" do
+		descriptor = run{selector.io_open(Fiber.current, file.path, File::RDWR, 0)}
+		expect(descriptor).to be >= 0
+		
+		io = IO.for_fd(descriptor, autoclose: true)
+		expect(io.close_on_exec?).to be == true
+		
+		io.write("Hello World")
+		io.close
+		
+		expect(File.read(file.path)).to be == "Hello World"
+	end
+	
+	it "can create a file" do
+		Dir.mktmpdir do |directory|
+			path = File.join(directory, "created")
+			
+			descriptor = run{selector.io_open(Fiber.current, path, File::CREAT | File::WRONLY, 0o600)}
+			expect(descriptor).to be >= 0
+			IO.for_fd(descriptor).close
+			
+			expect(File.stat(path).mode & 0o777).to be == 0o600
+		end
+	end
+	
+	it "fails to open a missing file" do
+		result = run{selector.io_open(Fiber.current, "/does/not/exist", File::RDONLY, 0)}
+		
+		expect(result).to be == -Errno::ENOENT::Errno
+	end
+	
+	it "can stat a file" do
+		file.write("Hello World")
+		file.flush
+		
+		stat = run{selector.io_stat(Fiber.current, file.path)}
+		expected = File.stat(file.path)
+		
+		expect(stat).to be_a(File::Stat)
+		expect(stat.size).to be == 11
+		expect(stat.ino).to be == expected.ino
+		expect(stat.dev).to be == expected.dev
+		expect(stat.mode).to be == expected.mode
+		expect(stat.mtime).to be == expected.mtime
+	end
+	
+	it "fails to stat a missing file" do
+		result = run{selector.io_stat(Fiber.current, "/does/not/exist")}
+		
+		expect(result).to be == -Errno::ENOENT::Errno
+	end
+	
+	it "can sync a file" do
+		file.write("Hello World")
+		file.flush
+		
+		expect(run{selector.io_fsync(Fiber.current, file)}).to be == 0
+		expect(run{selector.io_fsync(Fiber.current, file, true)}).to be == 0
+	end
+	
+	it "can allocate space for a file" do
+		result = run{selector.io_fallocate(Fiber.current, file, 0, 4096)}
+		
+		# Some file systems (e.g. tmpfs on older kernels) don't support fallocate:
+		skip "fallocate is not supported" if result == -Errno::EOPNOTSUPP::Errno
+		
+		expect(result).to be == 0
+		expect(File.size(file.path)).to be == 4096
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	next unless klass.method_defined?(:io_open)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like FileOperations
+	end
+end
@@ -0,0 +1,108 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+FixedFiles = Sus::Shared("fixed files") do
+	let(:pipe) {IO.pipe}
+	let(:input) {pipe.first}
+	let(:output) {pipe.last}
+	
+	after do
+		input.close unless input.closed?
+		output.close unless output.closed?
+	end
+	
+	def run_until_finished(fiber)
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+	end
+	
+	it "can read and write registered descriptors" do
+		expect(selector.register(input)).to be == true
+		expect(selector.register(output)).to be == true
+		
+		result = nil
+		
+		reader = Fiber.new do
+			buffer = IO::Buffer.new(64)
+			length = selector.io_read(Fiber.current, input, buffer, 1)
+			result = buffer.get_string(0, length)
+		end
+		
+		reader.transfer
+		
+		run_until_finished(Fiber.new do
+			selector.io_write(Fiber.current, output, IO::Buffer.for("Hello World"), 11)
+		end)
+		
+		selector.select(1) while reader.alive?
+		
+		expect(result).to be == "Hello World"
+	end
+	
+	it "can unregister descriptors" do
+		selector.register(input)
+		
+		expect(selector.unregister(input)).to be == true
+		expect(selector.unregister(input)).to be == false
+	end
+	
+	it "unregisters descriptors when they are closed" do
+		selector.register(input)
+		
+		# Hand ownership of the descriptor to `io_close`:
+		input.autoclose = false
+		selector.io_close(input.fileno)
+		
+		# The new pipe will typically reuse the closed descriptor:
+		other, writer = IO.pipe
+		
+		begin
+			expect(selector.register(other)).to be == true
+			writer.write("Hello World")
+			
+			result = nil
+			run_until_finished(Fiber.new do
+				buffer = IO::Buffer.new(64)
+				length = selector.io_read(Fiber.current, other, buffer, 1)
+				result = buffer.get_string(0, length)
+			end)
+			
+			expect(result).to be == "Hello World"
+		ensure
+			selector.unregister(other)
+			other.close
+			writer.close
+		end
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Fixed files are currently only implemented by `URing`:
+	next unless klass.method_defined?(:register)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like FixedFiles
+	end
+end
@@ -0,0 +1,135 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+IOAccept = Sus::Shared("io accept") do
+	let(:server) {TCPServer.new("localhost", 0)}
+	let(:port) {server.local_address.ip_port}
+	
+	after do
+		server.close unless server.closed?
+	end
+	
+	def run_until_finished(fiber)
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+	end
+	
+	it "can accept a connection" do
+		client = TCPSocket.new("localhost", port)
+		peer = nil
+		
+		run_until_finished(Fiber.new do
+			peer = Socket.for_fd(selector.io_accept(Fiber.current, server))
+		end)
+		
+		peer.write("Hello")
+		expect(client.read(5)).to be == "Hello"
+	ensure
+		client&.close
+		peer&.close
+	end
+	
+	it "can accept several connections from one multishot accept" do
+		peers = []
+		clients = []
+		
+		run_until_finished(Fiber.new do
+			4.times do
+				clients << TCPSocket.new("localhost", port)
+				peers << Socket.for_fd(selector.io_accept(Fiber.current, server))
+			end
+		end)
+		
+		expect(peers.size).to be == 4
+		expect(peers.map(&:fileno).uniq.size).to be == 4
+	ensure
+		clients.each(&:close)
+		peers.each(&:close)
+	end
+	
+	it "does not hand connections to a server which reuses the descriptor" do
+		client = TCPSocket.new("localhost", port)
+		
+		run_until_finished(Fiber.new do
+			Socket.for_fd(selector.io_accept(Fiber.current, server)).close
+		end)
+		
+		client.close
+		descriptor = server.fileno
+		
+		# Close the server without going through `io_close`, while the multishot accept is still armed:
+		server.close
+		
+		reused = TCPServer.new("localhost", 0)
+		skip "Descriptor was not reused!" unless reused.fileno == descriptor
+		
+		client = TCPSocket.new("localhost", reused.local_address.ip_port)
+		peer = nil
+		
+		run_until_finished(Fiber.new do
+			peer = Socket.for_fd(selector.io_accept(Fiber.current, reused))
+		end)
+		
+		expect(peer.local_address.ip_port).to be == reused.local_address.ip_port
+	ensure
+		client&.close
+		peer&.close
+		reused&.close
+	end
+	
+	it "fails waiting fibers when the server is closed" do
+		skip "Selector does not implement io_close!" unless selector.respond_to?(:io_close)
+		
+		error = nil
+		
+		fiber = Fiber.new do
+			selector.io_accept(Fiber.current, server)
+		rescue => error
+			# Expected.
+		end
+		
+		fiber.transfer
+		
+		selector.io_close(server.fileno)
+		
+		while fiber.alive?
+			selector.select(0)
+		end
+		
+		expect(error).to be_a(Errno::EBADF)
+	ensure
+		server.close rescue nil
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Multishot accept is currently only implemented by `URing`:
+	next unless klass.method_defined?(:io_accept)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like IOAccept
+	end
+end
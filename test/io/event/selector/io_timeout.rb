@@ -0,0 +1,93 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+IOTimeout = Sus::Shared("io timeout") do
+	let(:pipe) {IO.pipe}
+	let(:input) {pipe.first}
+	let(:output) {pipe.last}
+	
+	after do
+		input.close
+		output.close
+	end
+	
+	def run_until_finished(fiber)
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+	end
+	
+	it "can time out waiting for readability" do
+		result = :pending
+		
+		run_until_finished(Fiber.new do
+			result = selector.io_wait(Fiber.current, input, IO::READABLE, 0.01)
+		end)
+		
+		expect(result).to be == false
+	end
+	
+	it "can wait for readability before the timeout" do
+		output.write("Hello World")
+		result = nil
+		
+		run_until_finished(Fiber.new do
+			result = selector.io_wait(Fiber.current, input, IO::READABLE, 1.0)
+		end)
+		
+		expect(result).to be == IO::READABLE
+	end
+	
+	it "can time out reading" do
+		result = nil
+		
+		run_until_finished(Fiber.new do
+			buffer = IO::Buffer.new(64)
+			result = selector.io_read(Fiber.current, input, buffer, 1, 0, 0.01)
+		end)
+		
+		expect(result).to be == -Errno::ETIMEDOUT::Errno
+	end
+	
+	it "can read before the timeout" do
+		output.write("Hello World")
+		result = nil
+		
+		run_until_finished(Fiber.new do
+			buffer = IO::Buffer.new(64)
+			result = selector.io_read(Fiber.current, input, buffer, 1, 0, 1.0)
+		end)
+		
+		expect(result).to be == 11
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Kernel-side timeouts are currently only implemented by `URing`, using linked timeouts:
+	next unless name == :URing
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like IOTimeout
+	end
+end
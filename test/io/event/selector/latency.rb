@@ -0,0 +1,80 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+Latency = Sus::Shared("latency") do
+	it "is disabled by default" do
+		expect(selector.latency_tracking).to be == false
+		expect(selector.latency_histogram).to be_nil
+	end
+	
+	it "records the latency of ready fibers" do
+		selector.latency_tracking = true
+		
+		fiber = Fiber.new do
+			selector.yield
+		end
+		
+		fiber.transfer
+		selector.select(0)
+		
+		histogram = selector.latency_histogram
+		expect(histogram.size).to be == 40
+		expect(histogram.sum).to be == 1
+	end
+	
+	it "records the latency of events" do
+		selector.latency_tracking = true
+		input, output = IO.pipe
+		
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, input, IO::READABLE)
+		end
+		
+		fiber.transfer
+		output.write(".")
+		selector.select(1) while fiber.alive?
+		
+		expect(selector.latency_histogram.sum).to be >= 1
+	ensure
+		input&.close
+		output&.close
+	end
+	
+	it "clears the histogram when enabled" do
+		selector.latency_tracking = true
+		selector.push(Fiber.new{})
+		selector.select(0)
+		
+		selector.latency_tracking = false
+		selector.latency_tracking = true
+		
+		expect(selector.latency_histogram.sum).to be == 0
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	next unless klass.method_defined?(:latency_tracking=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like Latency
+	end
+end
@@ -0,0 +1,63 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+return unless IO::Event::Selector.const_defined?(:EPoll)
+
+describe IO::Event::Selector::EPoll do
+	let(:loop) {Fiber.current}
+	
+	def wait_readable(selector, pipes)
+		fibers = pipes.map do |input, output|
+			Fiber.new do
+				selector.io_wait(Fiber.current, input, IO::READABLE)
+			end.tap(&:transfer)
+		end
+		
+		pipes.each{|input, output| output.write(".")}
+		
+		while fibers.any?(&:alive?)
+			selector.select(0)
+		end
+	end
+	
+	it "has a default batch size" do
+		selector = subject.new(loop)
+		
+		expect(selector.statistics[:max_events]).to be == 64
+	ensure
+		selector&.close
+	end
+	
+	it "rejects invalid batch sizes" do
+		expect{subject.new(loop, max_events: 0)}.to raise_exception(ArgumentError)
+	end
+	
+	it "can read the batch size from the environment" do
+		selector = IO::Event::Selector.new(loop, {"IO_EVENT_SELECTOR" => "EPoll", "IO_EVENT_SELECTOR_EPOLL_MAX_EVENTS" => "128"})
+		
+		expect(selector.statistics[:max_events]).to be == 128
+	ensure
+		selector&.close
+	end
+	
+	it "grows the batch size when batches are full" do
+		selector = subject.new(loop, max_events: 2)
+		pipes = 8.times.map{IO.pipe}
+		
+		wait_readable(selector, pipes)
+		
+		statistics = selector.statistics
+		expect(statistics[:max_events]).to be > 2
+		expect(statistics[:full_batches]).to be > 0
+		expect(statistics[:batch_events]).to be == 8
+		expect(statistics[:batch_capacity]).to be >= statistics[:batch_events]
+	ensure
+		selector&.close
+		pipes&.each{|pipe| pipe.each(&:close)}
+	end
+end
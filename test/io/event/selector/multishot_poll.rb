@@ -0,0 +1,156 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+MultishotPoll = Sus::Shared("multishot poll") do
+	let(:sockets) {UNIXSocket.pair}
+	let(:local) {sockets.first}
+	let(:remote) {sockets.last}
+	
+	before do
+		selector.multishot_poll = true
+	end
+	
+	after do
+		local.close unless local.closed?
+		remote.close unless remote.closed?
+	end
+	
+	def run_until_finished(fiber)
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+	end
+	
+	it "can be enabled" do
+		expect(selector.multishot_poll).to be == true
+	end
+	
+	it "can wait for readability repeatedly" do
+		results = []
+		
+		reader = Fiber.new do
+			3.times do
+				results << selector.io_wait(Fiber.current, local, IO::READABLE)
+				local.read_nonblock(1024)
+			end
+		end
+		
+		reader.transfer
+		
+		3.times do |index|
+			remote.write("Hello")
+			selector.select(1) while results.size <= index
+		end
+		
+		expect(results).to be == [IO::READABLE] * 3
+		expect(reader).not.to be(:alive?)
+	end
+	
+	it "can wait for different events on the same descriptor" do
+		readable = writable = nil
+		
+		run_until_finished(Fiber.new do
+			writable = selector.io_wait(Fiber.current, local, IO::WRITABLE)
+		end)
+		
+		remote.write("Hello")
+		
+		run_until_finished(Fiber.new do
+			readable = selector.io_wait(Fiber.current, local, IO::READABLE)
+		end)
+		
+		expect(writable).to be == IO::WRITABLE
+		expect(readable).to be == IO::READABLE
+	end
+	
+	it "reports readiness which occurred while nobody was waiting" do
+		results = []
+		
+		remote.write("Hello")
+		
+		run_until_finished(Fiber.new do
+			results << selector.io_wait(Fiber.current, local, IO::READABLE)
+			local.read_nonblock(1024)
+		end)
+		
+		# The poll is cancelled once nobody is waiting, but arming it again reports this:
+		remote.write("World")
+		selector.select(0)
+		
+		run_until_finished(Fiber.new do
+			results << selector.io_wait(Fiber.current, local, IO::READABLE)
+		end)
+		
+		expect(results).to be == [IO::READABLE, IO::READABLE]
+	end
+	
+	it "releases the file once nobody is waiting" do
+		remote.write("Hello")
+		
+		run_until_finished(Fiber.new do
+			selector.io_wait(Fiber.current, local, IO::READABLE)
+		end)
+		
+		# Close without `io_close`, as older versions of Ruby do:
+		local.close
+		
+		# Submit the cancellation of the poll, which releases the file:
+		selector.select(0)
+		
+		expect(remote.wait_readable(1)).to be == remote
+		expect(remote.read_nonblock(1024, exception: false)).to be_nil
+	end
+	
+	it "fails waiting fibers when the descriptor is closed" do
+		error = nil
+		
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, local, IO::READABLE)
+		rescue => error
+			# Expected.
+		end
+		
+		fiber.transfer
+		
+		# Hand ownership of the descriptor to `io_close`:
+		local.autoclose = false
+		selector.io_close(local.fileno)
+		
+		while fiber.alive?
+			selector.select(0)
+		end
+		
+		expect(error).to be_a(Errno::EBADF)
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Multishot polls are currently only implemented by `URing`:
+	next unless klass.method_defined?(:multishot_poll=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like MultishotPoll
+	end
+end
@@ -0,0 +1,126 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+OptimisticIO = Sus::Shared("optimistic io") do
+	let(:sockets) {UNIXSocket.pair}
+	let(:local) {sockets.first}
+	let(:remote) {sockets.last}
+	
+	before do
+		selector.optimistic_io = true
+	end
+	
+	after do
+		local.close unless local.closed?
+		remote.close unless remote.closed?
+	end
+	
+	it "can be enabled" do
+		expect(selector.optimistic_io).to be == true
+	end
+	
+	it "reads buffered data directly" do
+		remote.write("Hello")
+		
+		# The read completes without yielding to the event loop:
+		buffer = IO::Buffer.new(5)
+		expect(selector.io_read(Fiber.current, local, buffer, 5, 0)).to be == 5
+		expect(buffer.get_string).to be == "Hello"
+		
+		expect(selector.statistics[:optimistic_hits]).to be == 1
+	end
+	
+	it "falls back to the ring if the read would block" do
+		result = nil
+		
+		reader = Fiber.new do
+			buffer = IO::Buffer.new(5)
+			result = selector.io_read(Fiber.current, local, buffer, 5, 0)
+		end
+		
+		reader.transfer
+		expect(selector.statistics[:optimistic_misses]).to be == 1
+		
+		remote.write("Hello")
+		selector.select(1) while reader.alive?
+		
+		expect(result).to be == 5
+	end
+	
+	it "writes directly" do
+		buffer = IO::Buffer.for("Hello")
+		expect(selector.io_write(Fiber.current, local, buffer, 5, 0)).to be == 5
+		expect(remote.read(5)).to be == "Hello"
+		
+		expect(selector.statistics[:optimistic_hits]).to be == 1
+	end
+	
+	it "can read from a descriptor reused by a pipe" do
+		remote.write("Hello")
+		buffer = IO::Buffer.new(5)
+		expect(selector.io_read(Fiber.current, local, buffer, 5, 0)).to be == 5
+		
+		descriptor = local.fileno
+		local.close
+		
+		# The descriptor is reused without going through `io_close`:
+		IO.pipe do |input, output|
+			expect(input.fileno).to be == descriptor
+			
+			output.write("World")
+			expect(selector.io_read(Fiber.current, input, buffer, 5, 0)).to be == 5
+			expect(buffer.get_string).to be == "World"
+		end
+	end
+	
+	it "backs off after repeated misses" do
+		reader = Fiber.new do
+			buffer = IO::Buffer.new(1)
+			
+			10.times do
+				selector.io_read(Fiber.current, local, buffer, 1, 0)
+			end
+		end
+		
+		reader.transfer
+		
+		10.times do
+			remote.write("x")
+			selector.select(1)
+		end
+		
+		expect(reader).not.to be(:alive?)
+		
+		# Every read had to wait, but not every read made an optimistic attempt:
+		expect(selector.statistics[:optimistic_misses]).to be < 10
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Optimistic reads and writes are currently only implemented by `URing`:
+	next unless klass.method_defined?(:optimistic_io=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like OptimisticIO
+	end
+end
@@ -0,0 +1,119 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+ProvidedBuffers = Sus::Shared("provided buffers") do
+	let(:pipe) {IO.pipe}
+	let(:input) {pipe.first}
+	let(:output) {pipe.last}
+	
+	before do
+		begin
+			selector.provide_buffers(4, 64)
+		rescue Errno::EINVAL, Errno::ENOSYS
+			skip "Provided buffer rings are not supported by this kernel!"
+		end
+	end
+	
+	after do
+		input.close
+		output.close
+	end
+	
+	def run_until_finished(fiber)
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+	end
+	
+	it "can't provide buffers twice" do
+		expect do
+			selector.provide_buffers(4, 64)
+		end.to raise_exception(RuntimeError, message: be =~ /already/)
+	end
+	
+	it "can read into a provided buffer" do
+		result = nil
+		
+		output.write("Hello World")
+		
+		run_until_finished(Fiber.new do
+			result = selector.io_read_provided(Fiber.current, input)
+		end)
+		
+		expect(result).to be_a(IO::Buffer)
+		expect(result.get_string).to be == "Hello World"
+	end
+	
+	it "can yield a view of the provided buffer" do
+		view = nil
+		result = nil
+		
+		output.write("Hello World")
+		
+		run_until_finished(Fiber.new do
+			result = selector.io_read_provided(Fiber.current, input) do |buffer|
+				view = buffer
+				buffer.get_string
+			end
+		end)
+		
+		expect(result).to be == "Hello World"
+		
+		# The view is invalidated once the buffer is recycled:
+		expect(view).to be(:null?)
+	end
+	
+	it "can reuse provided buffers" do
+		results = []
+		
+		run_until_finished(Fiber.new do
+			8.times do |index|
+				output.write("Message #{index}")
+				results << selector.io_read_provided(Fiber.current, input, &:get_string)
+			end
+		end)
+		
+		expect(results).to be == 8.times.map{|index| "Message #{index}"}
+	end
+	
+	it "returns nil at end of file" do
+		output.close
+		result = :pending
+		
+		run_until_finished(Fiber.new do
+			result = selector.io_read_provided(Fiber.current, input)
+		end)
+		
+		expect(result).to be_nil
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Provided buffer rings are currently only implemented by `URing`:
+	next unless klass.method_defined?(:io_read_provided)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like ProvidedBuffers
+	end
+end
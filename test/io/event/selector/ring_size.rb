@@ -0,0 +1,116 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+return unless IO::Event::Selector.const_defined?(:URing)
+
+describe IO::Event::Selector::URing do
+	let(:loop) {Fiber.current}
+	
+	it "has a default ring size" do
+		selector = subject.new(loop)
+		statistics = selector.statistics
+		
+		expect(statistics[:submission_entries]).to be == 64
+		expect(statistics[:completion_entries]).to be == 256
+	ensure
+		selector&.close
+	end
+	
+	it "can configure the ring size" do
+		selector = subject.new(loop, entries: 1024, completion_entries: 4096)
+		statistics = selector.statistics
+		
+		expect(statistics[:submission_entries]).to be == 1024
+		expect(statistics[:completion_entries]).to be == 4096
+	ensure
+		selector&.close
+	end
+	
+	it "rejects invalid ring sizes" do
+		expect{subject.new(loop, entries: 0)}.to raise_exception(ArgumentError)
+		expect{subject.new(loop, entries: 64, completion_entries: 32)}.to raise_exception(ArgumentError)
+	end
+	
+	it "can read the ring size from the environment" do
+		selector = IO::Event::Selector.new(loop, {"IO_EVENT_SELECTOR" => "URing", "IO_EVENT_SELECTOR_URING_ENTRIES" => "128"})
+		
+		expect(selector.statistics[:submission_entries]).to be == 128
+	ensure
+		selector&.close
+	end
+	
+	it "can use a kernel thread to poll the submission queue" do
+		selector = subject.new(loop, sqpoll: true, sq_thread_idle: 0.01)
+		input, output = IO.pipe
+		
+		# The kernel may refuse to create the thread, in which case a regular ring is used:
+		expect(selector.sqpoll?).to be == selector.statistics.key?(:sqpoll_wakeups)
+		
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, input, IO::READABLE)
+		end
+		
+		fiber.transfer
+		output.write("Hello")
+		selector.select(1) while fiber.alive?
+	ensure
+		input&.close
+		output&.close
+		selector&.close
+	end
+	
+	it "rejects invalid submission queue polling options" do
+		expect{subject.new(loop, sqpoll: true, sq_thread_cpu: -1)}.to raise_exception(ArgumentError)
+		expect{subject.new(loop, sqpoll: true, sq_thread_idle: -1)}.to raise_exception(ArgumentError)
+	end
+	
+	it "counts when the submission queue is full" do
+		selector = subject.new(loop, entries: 2)
+		input, output = IO.pipe
+		
+		fibers = 8.times.map do
+			Fiber.new do
+				selector.io_wait(Fiber.current, input, IO::READABLE)
+			end.tap(&:transfer)
+		end
+		
+		expect(selector.statistics[:submission_queue_full]).to be > 0
+		
+		output.write("Hello")
+		selector.select(0) while fibers.any?(&:alive?)
+	ensure
+		input&.close
+		output&.close
+		selector&.close
+	end
+	
+	it "batches submissions from several fibers" do
+		selector = subject.new(loop)
+		pipes = 4.times.map{IO.pipe}
+		
+		fibers = pipes.map do |input, output|
+			Fiber.new do
+				buffer = IO::Buffer.new(64)
+				selector.io_read(Fiber.current, input, buffer, 1)
+			end.tap(&:transfer)
+		end
+		
+		before = selector.statistics
+		selector.select(0)
+		after = selector.statistics
+		
+		expect(after[:submissions] - before[:submissions]).to be == 1
+		expect(after[:submitted_entries] - before[:submitted_entries]).to be >= pipes.size
+		
+		pipes.each{|input, output| output.write("Hello")}
+		selector.select(0) while fibers.any?(&:alive?)
+	ensure
+		pipes&.flatten&.each(&:close)
+		selector&.close
+	end
+end
@@ -0,0 +1,81 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+Spin = Sus::Shared("spin") do
+	it "can set the spin budget" do
+		expect(selector.spin).to be == 0.0
+		
+		selector.spin = 0.00005
+		expect(selector.spin).to be_within(0.000001).of(0.00005)
+		
+		selector.spin = nil
+		expect(selector.spin).to be == 0.0
+	end
+	
+	it "rejects a negative spin budget" do
+		expect{selector.spin = -1}.to raise_exception(ArgumentError)
+	end
+	
+	it "picks up events while spinning" do
+		input, output = IO.pipe
+		selector.spin = 1
+		
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, input, IO::READABLE)
+		end
+		
+		fiber.transfer
+		
+		# The spinning selector holds the GVL, so the data has to come from another process:
+		pid = Process.spawn("sleep 0.01; echo", out: output)
+		
+		selector.select(2) while fiber.alive?
+		
+		statistics = selector.statistics
+		expect(statistics[:spins]).to be >= 1
+		expect(statistics[:spin_hits]).to be >= 1
+	ensure
+		Process.wait(pid) if pid
+		input&.close
+		output&.close
+	end
+	
+	it "doesn't spin for longer than the timeout" do
+		selector.spin = 1
+		
+		start_time = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+		selector.select(0.01)
+		duration = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start_time
+		
+		expect(duration).to be < 0.5
+		expect(selector.statistics[:spin_hits]).to be == 0
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Spinning before blocking is implemented by `EPoll` and `URing`:
+	next unless klass.method_defined?(:spin=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like Spin
+	end
+end
@@ -0,0 +1,135 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+require "tempfile"
+
+Splice = Sus::Shared("splice") do
+	let(:file) {Tempfile.new}
+	let(:data) {Random.bytes(1024 * 256)}
+	
+	before do
+		file.write(data)
+		file.flush
+		file.rewind
+	end
+	
+	after do
+		file.close!
+	end
+	
+	def run
+		result = nil
+		
+		fiber = Fiber.new do
+			result = yield
+		end
+		
+		fiber.transfer
+		
+		while fiber.alive?
+			selector.select(1)
+		end
+		
+		return result
+	end
+	
+	it "can transfer a file to a socket" do
+		client, server = UNIXSocket.pair
+		reader = Thread.new{server.read}
+		
+		result = run do
+			selector.io_splice(Fiber.current, file, client, data.bytesize)
+		ensure
+			client.close
+		end
+		
+		expect(result).to be == data.bytesize
+		expect(reader.value).to be == data
+	ensure
+		server&.close
+	end
+	
+	it "reports the data transferred before an error" do
+		client, server = UNIXSocket.pair
+		
+		# Ensure the transfer can't complete before the reader stops reading:
+		client.setsockopt(Socket::SOL_SOCKET, Socket::SO_SNDBUF, 4096)
+		
+		reader = Thread.new do
+			server.read(1024 * 64)
+		ensure
+			server.close
+		end
+		
+		result = run do
+			selector.io_splice(Fiber.current, file, client, data.bytesize)
+		end
+		
+		expect(reader.value).to be == data.byteslice(0, 1024 * 64)
+		expect(result).to be >= 1024 * 64
+	ensure
+		client&.close
+	end
+	
+	it "can transfer part of a file to a pipe" do
+		input, output = IO.pipe
+		
+		file.seek(1024)
+		result = run{selector.io_splice(Fiber.current, file, output, 1024)}
+		
+		expect(result).to be == 1024
+		expect(input.read_nonblock(4096)).to be == data.byteslice(1024, 1024)
+		
+		# The file position advances:
+		expect(file.pos).to be == 2048
+	ensure
+		input&.close
+		output&.close
+	end
+	
+	it "stops at the end of the file" do
+		input, output = IO.pipe
+		input.binmode
+		reader = Thread.new{input.read}
+		
+		file.seek(data.bytesize - 100)
+		
+		result = run do
+			selector.io_splice(Fiber.current, file, output, 4096)
+		ensure
+			output.close
+		end
+		
+		expect(result).to be == 100
+		expect(reader.value).to be == data.byteslice(-100, 100)
+	ensure
+		input&.close
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	next unless klass.method_defined?(:io_splice)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like Splice
+	end
+end
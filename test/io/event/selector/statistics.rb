@@ -0,0 +1,122 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+
+Statistics = Sus::Shared("statistics") do
+	let(:pipe) {IO.pipe}
+	let(:input) {pipe.first}
+	let(:output) {pipe.last}
+	
+	after do
+		input.close
+		output.close
+	end
+	
+	it "reports the common counters" do
+		statistics = selector.statistics
+		
+		[:selects, :blocking_waits, :events, :ready_flushes, :ready_resumes, :wakeups, :wakeup_signals, :cancellations].each do |key|
+			expect(statistics[key]).to be == 0
+		end
+	end
+	
+	it "counts selects and blocking waits" do
+		selector.select(0)
+		selector.select(0.001)
+		
+		statistics = selector.statistics
+		expect(statistics[:selects]).to be == 2
+		expect(statistics[:blocking_waits]).to be == 1
+	end
+	
+	it "counts events and ready fibers" do
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, input, IO::READABLE)
+			selector.yield
+		end
+		
+		fiber.transfer
+		output.write(".")
+		
+		selector.select(1) while fiber.alive?
+		
+		statistics = selector.statistics
+		expect(statistics[:events]).to be >= 1
+		expect(statistics[:ready_flushes]).to be == 1
+		expect(statistics[:ready_resumes]).to be == 1
+	end
+	
+	it "counts wakeups" do
+		selector.wakeup
+		
+		statistics = selector.statistics
+		expect(statistics[:wakeups]).to be == 1
+		expect(statistics[:wakeup_signals]).to be == 0
+	end
+	
+	it "signals the event loop once for fibers pushed while it is blocked" do
+		count = 0
+		
+		fibers = 100.times.map do
+			Fiber.new do
+				count += 1
+				loop.transfer
+			end
+		end
+		
+		thread = Thread.new do
+			# Wait for the event loop to block:
+			sleep(0.01)
+			
+			fibers.each{|fiber| selector.push_remote(fiber)}
+		end
+		
+		selector.select(1)
+		selector.select(0.01) while count < fibers.size
+		
+		statistics = selector.statistics
+		expect(statistics[:wakeup_signals]).to be >= 1
+		expect(statistics[:wakeup_signals]).to be <= statistics[:blocking_waits]
+	ensure
+		thread&.join
+	end
+	
+	it "counts cancellations" do
+		fiber = Fiber.new do
+			selector.io_wait(Fiber.current, input, IO::READABLE)
+		rescue Interrupt
+			# Cancelled.
+		end
+		
+		fiber.transfer
+		fiber.raise(Interrupt)
+		
+		expect(selector.statistics[:cancellations]).to be == 1
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	next unless klass.method_defined?(:statistics)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like Statistics
+	end
+end
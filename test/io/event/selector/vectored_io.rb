@@ -0,0 +1,104 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+VectoredIO = Sus::Shared("vectored io") do
+	let(:pipe) {IO.pipe}
+	let(:input) {pipe.first}
+	let(:output) {pipe.last}
+	
+	after do
+		input.close
+		output.close
+	end
+	
+	it "can write several buffers" do
+		buffers = [IO::Buffer.for("Hello"), IO::Buffer.for(" "), IO::Buffer.for("World")]
+		
+		expect(selector.io_writev(Fiber.current, output, buffers)).to be == 11
+		expect(input.read_nonblock(64)).to be == "Hello World"
+	end
+	
+	it "can read into several buffers" do
+		buffers = [IO::Buffer.new(5), IO::Buffer.new(64)]
+		result = nil
+		
+		reader = Fiber.new do
+			result = selector.io_readv(Fiber.current, input, buffers)
+		end
+		
+		reader.transfer
+		output.write("Hello World")
+		
+		while reader.alive?
+			selector.select(1)
+		end
+		
+		expect(result).to be == 11
+		expect(buffers[0].get_string).to be == "Hello"
+		expect(buffers[1].get_string(0, 6)).to be == " World"
+	end
+	
+	it "can read end of file" do
+		output.close
+		
+		buffers = [IO::Buffer.new(64)]
+		expect(selector.io_readv(Fiber.current, input, buffers)).to be == 0
+	end
+	
+	it "can write more than the pipe capacity" do
+		chunk = "x" * 1024 * 64
+		buffers = 4.times.map{IO::Buffer.for(chunk)}
+		written = nil
+		
+		writer = Fiber.new do
+			written = selector.io_writev(Fiber.current, output, buffers)
+			output.close
+		end
+		
+		reader = Thread.new{input.read}
+		
+		writer.transfer
+		
+		while writer.alive?
+			selector.select(1)
+		end
+		
+		expect(written).to be == chunk.bytesize * 4
+		expect(reader.value.bytesize).to be == chunk.bytesize * 4
+	end
+	
+	it "fails when writing to a closed pipe" do
+		input.close
+		
+		buffers = [IO::Buffer.for("Hello")]
+		expect(selector.io_writev(Fiber.current, output, buffers)).to be == -Errno::EPIPE::Errno
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	next unless klass.method_defined?(:io_writev)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like VectoredIO
+	end
+end
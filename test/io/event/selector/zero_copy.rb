@@ -0,0 +1,98 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event"
+require "io/event/selector"
+require "socket"
+
+ZeroCopy = Sus::Shared("zero copy") do
+	let(:threshold) {1024 * 64}
+	let(:size) {1024 * 1024}
+	
+	before do
+		selector.zero_copy_threshold = threshold
+	rescue NotImplementedError => error
+		skip error.message
+	end
+	
+	def run_until_finished(*fibers)
+		fibers.each(&:transfer)
+		
+		while fibers.any?(&:alive?)
+			selector.select(1)
+		end
+	end
+	
+	it "can set the threshold" do
+		expect(selector.zero_copy_threshold).to be == threshold
+		
+		selector.zero_copy_threshold = nil
+		expect(selector.zero_copy_threshold).to be_nil
+	end
+	
+	it "can write large buffers to a socket" do
+		server = TCPServer.new("localhost", 0)
+		client = TCPSocket.new("localhost", server.local_address.ip_port)
+		peer = server.accept
+		
+		data = Random.bytes(size)
+		written = nil
+		
+		reader = Thread.new{peer.read}
+		
+		run_until_finished(Fiber.new do
+			written = selector.io_write(Fiber.current, client, IO::Buffer.for(data), size)
+			client.close_write
+		end)
+		
+		expect(written).to be == size
+		expect(reader.value).to be == data
+	ensure
+		peer&.close
+		client&.close
+		server&.close
+	end
+	
+	it "falls back to a regular write for pipes" do
+		input, output = IO.pipe
+		data = "x" * threshold
+		written = nil
+		
+		reader = Thread.new{input.read(threshold)}
+		
+		run_until_finished(Fiber.new do
+			written = selector.io_write(Fiber.current, output, IO::Buffer.for(data), threshold)
+		end)
+		
+		expect(written).to be == threshold
+		expect(reader.value).to be == data
+	ensure
+		input&.close
+		output&.close
+	end
+end
+
+IO::Event::Selector.constants.each do |name|
+	klass = IO::Event::Selector.const_get(name)
+	
+	# Zero-copy sends are currently only implemented by `URing`:
+	next unless klass.method_defined?(:zero_copy_threshold=)
+	
+	describe(klass, unique: name) do
+		before do
+			@loop = Fiber.current
+			@selector = subject.new(@loop)
+		end
+		
+		after do
+			@selector&.close
+		end
+		
+		attr :loop
+		attr :selector
+		
+		it_behaves_like ZeroCopy
+	end
+end
@@ -4,6 +4,7 @@
 # Copyright, 2024-2026, by Samuel Williams.
 
 require "io/event/timers"
+require "io/event"
 
 class FloatWrapper
 	def initialize(value)
@@ -15,9 +16,7 @@ class FloatWrapper
 	end
 end
 
-describe IO::Event::Timers do
-	let(:timers) {subject.new}
-	
+Timers = Sus::Shared("timers") do |retains_cancelled = true|
 	it "should register an event" do
 		fired = false
 		
@@ -91,32 +90,35 @@ describe IO::Event::Timers do
 		expect(timers.size).to be == 0
 	end
 	
-	it "should not compact half-cancelled timers from the heap" do
-		now = timers.now
-		count = subject::COMPACT_MINIMUM_COUNT
-		handles = (count * 2).times.map do |index|
-			timers.schedule(now + index, proc{})
+	# Timing wheels release cancelled timers eagerly, so only the heap retains them until compaction:
+	if retains_cancelled
+		it "should not compact half-cancelled timers from the heap" do
+			now = timers.now
+			count = subject::COMPACT_MINIMUM_COUNT
+			handles = (count * 2).times.map do |index|
+				timers.schedule(now + index, proc{})
+			end
+			
+			expect(timers.size).to be == count * 2
+			
+			handles.first(count).each(&:cancel!)
+			
+			expect(timers.size).to be == count * 2
 		end
 		
-		expect(timers.size).to be == count * 2
-		
-		handles.first(count).each(&:cancel!)
-		
-		expect(timers.size).to be == count * 2
-	end
-	
-	it "should compact more than half-cancelled timers from the heap" do
-		now = timers.now
-		count = subject::COMPACT_MINIMUM_COUNT
-		handles = (count * 2).times.map do |index|
-			timers.schedule(now + index, proc{})
+		it "should compact more than half-cancelled timers from the heap" do
+			now = timers.now
+			count = subject::COMPACT_MINIMUM_COUNT
+			handles = (count * 2).times.map do |index|
+				timers.schedule(now + index, proc{})
+			end
+			
+			expect(timers.size).to be == count * 2
+			
+			handles.first(count + 1).each(&:cancel!)
+			
+			expect(timers.size).to be == count - 1
 		end
-		
-		expect(timers.size).to be == count * 2
-		
-		handles.first(count + 1).each(&:cancel!)
-		
-		expect(timers.size).to be == count - 1
 	end
 	
 	it "should allow fired timers to be cancelled" do
@@ -171,6 +173,36 @@ describe IO::Event::Timers do
 		expect(timers.size).to be == 0
 	end
 	
+	it "should defer timers scheduled while firing until the next call" do
+		fired = []
+		now = timers.now
+		
+		timers.schedule(now, proc{fired << :first; timers.schedule(now, proc{fired << :second})})
+		
+		timers.fire(now)
+		expect(fired).to be == [:first]
+		
+		timers.fire(now)
+		expect(fired).to be == [:first, :second]
+	end
+	
+	it "should retain pending timers if a block raises" do
+		fired = []
+		now = timers.now
+		
+		timers.schedule(now + 0.1, proc{raise "Boom!"})
+		timers.schedule(now + 0.2, proc{fired << :second})
+		
+		expect do
+			timers.fire(now + 0.3)
+		end.to raise_exception(RuntimeError, message: be == "Boom!")
+		
+		expect(timers.size).to be == 1
+		
+		timers.fire(now + 0.3)
+		expect(fired).to be == [:second]
+	end
+	
 	with "#schedule" do
 		it "raises an error if given an invalid time" do
 			expect do
@@ -211,3 +243,49 @@ describe IO::Event::Timers do
 		end
 	end
 end
+
+describe IO::Event::Timers do
+	let(:timers) {subject.new}
+	
+	it_behaves_like Timers
+	
+	with "resolution: 0.001" do
+		let(:timers) {subject.new(resolution: 0.001)}
+		
+		it_behaves_like Timers, false
+		
+		it "should fire timers beyond the horizon of the timing wheel" do
+			fired = []
+			now = timers.now
+			
+			timers.schedule(now + 10.0, proc{fired << :far})
+			timers.schedule(now + 0.5, proc{fired << :near})
+			
+			expect(timers.size).to be == 2
+			expect(timers.wait_interval(now)).to be_within(0.001).of(0.5)
+			
+			timers.fire(now + 20.0)
+			
+			expect(fired).to be == [:near, :far]
+			expect(timers.size).to be == 0
+		end
+		
+		it "should fire overdue timers when given an earlier time" do
+			fired = false
+			
+			timers.schedule(1.0, proc{fired = true})
+			timers.fire(2.0)
+			
+			expect(fired).to be == true
+			expect(timers.size).to be == 0
+		end
+	end
+end
+
+if defined?(IO::Event::NativeTimers)
+	describe IO::Event::NativeTimers do
+		let(:timers) {subject.new}
+		
+		it_behaves_like Timers
+	end
+end
@@ -0,0 +1,75 @@
+# frozen_string_literal: true
+
+# Released under the MIT License.
+# Copyright, 2026, by Samuel Williams.
+
+require "io/event/timing_wheel"
+require "io/event/timers"
+
+describe IO::Event::TimingWheel do
+	let(:now) {100.0}
+	let(:timing_wheel) {subject.new(0.01, now, slots: 16)}
+	
+	def handle(time)
+		IO::Event::Timers::Handle.new(time, proc{})
+	end
+	
+	it "rejects handles beyond the horizon" do
+		expect(timing_wheel.horizon).to be_within(0.0001).of(0.16)
+		
+		expect(timing_wheel.insert(handle(now + 0.1))).to be == true
+		expect(timing_wheel.insert(handle(now + 1.0))).to be == false
+		expect(timing_wheel.size).to be == 1
+	end
+	
+	it "expires handles which are due" do
+		first = handle(now + 0.02)
+		second = handle(now + 0.05)
+		
+		timing_wheel.insert(second)
+		timing_wheel.insert(first)
+		
+		expect(timing_wheel.next_time).to be == first.time
+		expect(timing_wheel.expire(now + 0.03)).to be == [first]
+		expect(timing_wheel.size).to be == 1
+		expect(timing_wheel.next_time).to be == second.time
+	end
+	
+	it "stores overdue handles in the current slot" do
+		overdue = handle(now - 1.0)
+		
+		expect(timing_wheel.insert(overdue)).to be == true
+		expect(timing_wheel.expire(now)).to be == [overdue]
+	end
+	
+	it "expires overdue handles when the given time is before the current tick" do
+		overdue = handle(now - 1.0)
+		
+		timing_wheel.insert(overdue)
+		expect(timing_wheel.expire(now - 0.5)).to be == [overdue]
+		expect(timing_wheel).to be(:empty?)
+	end
+	
+	it "expires all handles when time advances beyond the horizon" do
+		handles = 10.times.map{|index| handle(now + index * 0.01)}
+		handles.each{|handle| timing_wheel.insert(handle)}
+		
+		expect(timing_wheel.expire(now + 10.0).size).to be == 10
+		expect(timing_wheel).to be(:empty?)
+		
+		# The wheel has advanced, so the horizon is relative to the new time:
+		expect(timing_wheel.insert(handle(now + 10.1))).to be == true
+	end
+	
+	it "does not retain cancelled handles" do
+		handles = (subject::COMPACT_MINIMUM_COUNT * 2).times.map do
+			handle(now + 0.1).tap{|handle| timing_wheel.insert(handle)}
+		end
+		
+		handles.each(&:cancel!)
+		
+		expect(timing_wheel.size).to be == 0
+		expect(timing_wheel.next_time).to be_nil
+		expect(timing_wheel.expire(now + 1.0)).to be == []
+	end
+end